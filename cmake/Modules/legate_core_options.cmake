@@ -78,6 +78,8 @@ endif()
 
 option(legate_core_STATIC_CUDA_RUNTIME "Statically link the cuda runtime library" OFF)
 option(legate_core_EXCLUDE_LEGION_FROM_ALL "Exclude Legion targets from legate.core's 'all' target" OFF)
+option(legate_core_BUILD_COLL_BENCH "Build the micro-benchmark of the CPU collectives" OFF)
+option(legate_core_BUILD_COLL_TESTS "Build the tests of the CPU collectives" OFF)
 
 set_or_default(NCCL_DIR NCCL_PATH)
 set_or_default(Thrust_DIR THRUST_PATH)
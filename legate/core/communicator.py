@@ -18,7 +18,9 @@ import struct
 from abc import ABC, abstractmethod, abstractproperty
 from typing import TYPE_CHECKING
 
-from . import FutureMap, Point, Rect
+import legate.core.types as ty
+
+from . import FutureMap, Rect, ffi
 
 if TYPE_CHECKING:
     from .runtime import Runtime
@@ -113,6 +115,22 @@ class NCCLCommunicator(Communicator):
         task.execute(Rect([volume]))
 
 
+_CPUCOLL_KINDS = {
+    "alltoallv": 0,
+    "alltoall": 1,
+    "allgather": 2,
+    "bcast": 3,
+    "gather": 4,
+    "allreduce": 5,
+    "reduce": 6,
+    "reduce_scatter": 7,
+    "ialltoallv": 8,
+    "iallgather": 9,
+    "iallreduce": 10,
+    "allgatherv": 11,
+}
+
+
 class CPUCommunicator(Communicator):
     def __init__(self, runtime: Runtime) -> None:
         super().__init__(runtime)
@@ -148,22 +166,56 @@ class CPUCommunicator(Communicator):
     def needs_barrier(self) -> bool:
         return self._needs_barrier
 
+    def statistics(self) -> dict[str, dict[str, float]]:
+        """
+        Returns the telemetry of the CPU collectives issued in this process,
+        keyed by collective. Telemetry is only collected when the
+        ``LEGATE_COLL_STATS`` environment variable is set; otherwise the
+        result is empty.
+        """
+        lib = self._runtime.core_library
+        stats = ffi.new("legate_cpucoll_stats_t*")
+        result: dict[str, dict[str, float]] = {}
+        for name, kind in _CPUCOLL_KINDS.items():
+            if not lib.legate_cpucoll_get_stats(kind, stats):
+                return {}
+            result[name] = {
+                "calls": stats.calls,
+                "bytes_sent": stats.bytes_sent,
+                "bytes_received": stats.bytes_received,
+                "time": stats.time,
+                "wait_time": stats.wait_time,
+                "max_skew": stats.max_skew,
+            }
+        return result
+
     def _initialize(self, volume: int) -> FutureMap:
         from .launcher import TaskLauncher as Task
+        from .partition import REPLICATE
 
         cpucoll_uid = self._runtime.core_library.legate_cpucoll_initcomm()
         buf = struct.pack("i", cpucoll_uid)
         cpucoll_uid_f = self._runtime.create_future(buf, len(buf))
+
+        # Each point writes its own entry of the mapping table, which is then
+        # broadcast to all points of the init task as a single store. The
+        # dependence on the store orders the two launches, so neither a fence
+        # nor a per-rank future argument is needed.
+        mapping_table = self._context.create_store(ty.int32, shape=(volume,))
         task = Task(self._context, self._init_cpucoll_mapping, tag=self._tag)
-        mapping_table_fm = task.execute(Rect([volume]))
+        task.add_output(
+            mapping_table,
+            mapping_table.partition_by_tiling((1,)).get_requirement(1),
+        )
+        task.execute(Rect([volume]))
+
         task = Task(self._context, self._init_cpucoll, tag=self._tag)
         task.add_future(cpucoll_uid_f)
-        for i in range(volume):
-            f = mapping_table_fm.get_future(Point([i]))
-            task.add_future(f)
-        handle = task.execute(Rect([volume]))
-        self._runtime.issue_execution_fence()
-        return handle
+        task.add_input(
+            mapping_table,
+            mapping_table.partition(REPLICATE).get_requirement(1),
+        )
+        return task.execute(Rect([volume]))
 
     def _finalize(self, volume: int, handle: FutureMap) -> None:
         from .launcher import TaskLauncher as Task
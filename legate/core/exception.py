@@ -16,7 +16,7 @@
 from __future__ import annotations
 
 import struct
-from typing import TYPE_CHECKING
+from typing import TYPE_CHECKING, Callable
 
 if TYPE_CHECKING:
     from types import TracebackType
@@ -24,25 +24,40 @@ if TYPE_CHECKING:
 
     from ._legion import Future
 
+# Layout of the status of a task that can raise an exception: the index of
+# the exception, or -1 if none was raised, the node that keeps the error
+# message and the linearized point that raised it. It must match
+# ExceptionStatus in src/core/task/return.h.
+_EXCEPTION_STATUS = struct.Struct("iIq")
+EXCEPTION_STATUS_SIZE = _EXCEPTION_STATUS.size
+
 
 class PendingException:
+    """
+    An exception that a task may have raised. The status is checked first,
+    and the error message is fetched from the node that keeps it only when
+    an exception was raised.
+    """
+
     def __init__(
         self,
         exn_types: list[type],
-        future: Future,
+        status: Future,
+        fetch_error_message: Callable[[int, int], Future],
         tb: Optional[TracebackType] = None,
     ):
         self._exn_types = exn_types
-        self._future = future
+        self._status = status
+        self._fetch_error_message = fetch_error_message
         self._tb = tb
 
     def raise_exception(self) -> None:
-        buf = self._future.get_buffer()
-        (raised,) = struct.unpack("?", buf[:1])
-        if not raised:
+        buf = self._status.get_buffer(EXCEPTION_STATUS_SIZE)
+        (exn_index, node, point) = _EXCEPTION_STATUS.unpack(buf[:])
+        if exn_index < 0:
             return
-        (exn_index, error_size) = struct.unpack("iI", buf[1:9])
-        error_message = buf[9 : 9 + error_size].decode()
+        future = self._fetch_error_message(node, point)
+        error_message = future.get_string().decode()
         exn_type = self._exn_types[exn_index]
         exn_reraised = exn_type(error_message)
         exn_original = exn_type(error_message).with_traceback(self._tb)
@@ -42,7 +42,7 @@ from . import (
     legion,
     types as ty,
 )
-from .runtime import runtime
+from .runtime import FutureSlice, runtime
 from .utils import OrderedSet
 
 if TYPE_CHECKING:
@@ -144,12 +144,18 @@ class ScalarArg:
 
 class FutureStoreArg:
     def __init__(
-        self, store: Store, read_only: bool, has_storage: bool, redop: int
+        self,
+        store: Store,
+        read_only: bool,
+        has_storage: bool,
+        redop: int,
+        offset: int = 0,
     ) -> None:
         self._store = store
         self._read_only = read_only
         self._has_storage = has_storage
         self._redop = redop
+        self._offset = offset
 
     def pack(self, buf: BufferBuilder) -> None:
         self._store.serialize(buf)
@@ -157,6 +163,7 @@ class FutureStoreArg:
         buf.pack_bool(self._read_only)
         buf.pack_bool(self._has_storage)
         buf.pack_32bit_int(self._store.type.size)
+        buf.pack_32bit_uint(self._offset)
         _pack(buf, self._store.extents, ty.int64, True)
 
     def __str__(self) -> str:
@@ -706,6 +713,7 @@ class TaskLauncher:
         self._has_side_effect = side_effect
         self._insert_barrier = False
         self._can_raise_exception = False
+        self._exception_id = 0
         self._provenance = provenance
 
     @property
@@ -766,9 +774,18 @@ class TaskLauncher:
             # the inverse isn't true.)
             has_storage = store.has_storage
             read_only = perm == Permission.READ
+            offset = 0
             if has_storage:
-                self.add_future(store.storage)
-            args.append(FutureStoreArg(store, read_only, has_storage, redop))
+                storage = store.storage
+                # A value packed with other return values of a task is read
+                # in place by the task
+                if isinstance(storage, FutureSlice):
+                    offset = storage.offset
+                    storage = storage.packed
+                self.add_future(storage)
+            args.append(
+                FutureStoreArg(store, read_only, has_storage, redop, offset)
+            )
 
         else:
             if TYPE_CHECKING:
@@ -855,8 +872,11 @@ class TaskLauncher:
     def insert_barrier(self) -> None:
         self._insert_barrier = True
 
-    def set_can_raise_exception(self, can_raise_exception: bool) -> None:
+    def set_can_raise_exception(
+        self, can_raise_exception: bool, exception_id: int = 0
+    ) -> None:
         self._can_raise_exception = can_raise_exception
+        self._exception_id = exception_id
 
     def set_sharding_space(self, space: IndexSpace) -> None:
         self._sharding_space = space
@@ -884,6 +904,8 @@ class TaskLauncher:
         self.pack_args(argbuf, self._reductions)
         self.pack_args(argbuf, self._scalars)
         argbuf.pack_bool(self._can_raise_exception)
+        if self._can_raise_exception:
+            argbuf.pack_64bit_uint(self._exception_id)
         argbuf.pack_bool(self._insert_barrier)
         argbuf.pack_32bit_uint(len(self._comms))
 
@@ -926,6 +948,8 @@ class TaskLauncher:
         self.pack_args(argbuf, self._reductions)
         self.pack_args(argbuf, self._scalars)
         argbuf.pack_bool(self._can_raise_exception)
+        if self._can_raise_exception:
+            argbuf.pack_64bit_uint(self._exception_id)
 
         assert len(self._comms) == 0
 
@@ -26,8 +26,9 @@ from typing import (
 
 import legate.core.types as ty
 
-from . import Future, FutureMap, Rect
+from . import Future, FutureMap, Rect, ffi
 from .constraints import PartSym
+from .exception import EXCEPTION_STATUS_SIZE
 from .launcher import CopyLauncher, FillLauncher, TaskLauncher
 from .partition import REPLICATE, Weighted
 from .shape import Shape
@@ -277,6 +278,17 @@ class Task(TaskProtocol):
         for (arg, dtype) in self._scalar_args:
             launcher.add_scalar_arg(arg, dtype)
 
+    def _return_value_sizes(self) -> list[int]:
+        # Unbound stores return their weights as size_t values
+        sizes = [ffi.sizeof("size_t")] * len(self.unbound_outputs)
+        for out_idx in self.scalar_outputs:
+            sizes.append(self.outputs[out_idx].type.size)
+        for red_idx in self.scalar_reductions:
+            sizes.append(self.reductions[red_idx][0].type.size)
+        if self.can_raise_exception:
+            sizes.append(EXCEPTION_STATUS_SIZE)
+        return sizes
+
     def _demux_scalar_stores_future(self, result: Future) -> None:
         num_unbound_outs = len(self.unbound_outputs)
         num_scalar_outs = len(self.scalar_outputs)
@@ -301,25 +313,27 @@ class Task(TaskProtocol):
                 output.set_storage(result)
             elif self.can_raise_exception:
                 runtime.record_pending_exception(
-                    self._exn_types, result, self._tb
+                    self._exn_types, result, self._op_id, self._tb
                 )
             else:
                 assert num_unbound_outs == 1
         else:
+            values = runtime.slice_return_values(
+                result, self._return_value_sizes()
+            )
+
             idx = len(self.unbound_outputs)
             for out_idx in self.scalar_outputs:
                 output = self.outputs[out_idx]
-                output.set_storage(runtime.extract_scalar(result, idx))
+                output.set_storage(values[idx])
                 idx += 1
             for red_idx in self.scalar_reductions:
                 (output, _) = self.reductions[red_idx]
-                output.set_storage(runtime.extract_scalar(result, idx))
+                output.set_storage(values[idx])
                 idx += 1
             if self.can_raise_exception:
                 runtime.record_pending_exception(
-                    self._exn_types,
-                    runtime.extract_scalar(result, idx),
-                    self._tb,
+                    self._exn_types, values[idx], self._op_id, self._tb
                 )
 
     def _demux_scalar_stores_future_map(
@@ -358,6 +372,7 @@ class Task(TaskProtocol):
                 runtime.record_pending_exception(
                     self._exn_types,
                     runtime.reduce_exception_future_map(result),
+                    self._op_id,
                     self._tb,
                 )
             else:
@@ -386,12 +401,13 @@ class Task(TaskProtocol):
                 output.set_storage(runtime.reduce_future_map(data, redop_id))
                 idx += 1
             if self.can_raise_exception:
-                exn_fut_map = runtime.extract_scalar_with_domain(
+                status_fut_map = runtime.extract_scalar_with_domain(
                     result, idx, launch_domain
                 )
                 runtime.record_pending_exception(
                     self._exn_types,
-                    runtime.reduce_exception_future_map(exn_fut_map),
+                    runtime.reduce_exception_future_map(status_fut_map),
+                    self._op_id,
                     self._tb,
                 )
 
@@ -607,7 +623,9 @@ class AutoTask(AutoOperation, Task):
 
         self._add_scalar_args_to_launcher(launcher)
 
-        launcher.set_can_raise_exception(self.can_raise_exception)
+        launcher.set_can_raise_exception(
+            self.can_raise_exception, self._op_id
+        )
 
         launch_domain = strategy.launch_domain if strategy.parallel else None
         self._add_communicators(launcher, launch_domain)
@@ -765,7 +783,9 @@ class ManualTask(Operation, Task):
 
         self._add_scalar_args_to_launcher(launcher)
 
-        launcher.set_can_raise_exception(self.can_raise_exception)
+        launcher.set_can_raise_exception(
+            self.can_raise_exception, self._op_id
+        )
 
         self._add_communicators(launcher, self._launch_domain)
 
@@ -20,7 +20,15 @@ import struct
 import weakref
 from collections import deque
 from dataclasses import dataclass
-from typing import TYPE_CHECKING, Any, Deque, List, Optional, TypeVar, Union
+from typing import (
+    TYPE_CHECKING,
+    Any,
+    Deque,
+    List,
+    Optional,
+    TypeVar,
+    Union,
+)
 
 from legion_top import add_cleanup_item, top_level
 
@@ -34,6 +42,7 @@ from . import (
     FutureMap,
     IndexSpace,
     OutputRegion,
+    Point,
     Rect,
     Region,
     legate_task_postamble,
@@ -71,8 +80,13 @@ T = TypeVar("T")
 
 _sizeof_int = ffi.sizeof("int")
 _sizeof_size_t = ffi.sizeof("size_t")
+_sizeof_uint32 = ffi.sizeof("uint32_t")
 assert _sizeof_size_t == 4 or _sizeof_size_t == 8
 
+# Alignment of the values in a future packing the return values of a task,
+# which must match the one in src/core/task/return.cc
+_RETURN_VALUE_ALIGNMENT = 16
+
 _LEGATE_FIELD_ID_BASE = 1000
 
 ARGS = [
@@ -791,6 +805,76 @@ class PartitionManager:
         self._index_partitions[key] = index_partition
 
 
+class FutureSlice(Future):
+    """
+    One of the values packed in the future that a task with multiple return
+    values produces. The value is decoded at its offset in the packed buffer,
+    both when it is read here and when it is passed to a task, so extracting
+    it takes no task launch. A standalone future is extracted only when
+    another Legion operation asks for the handle.
+    """
+
+    def __init__(self, packed: Future, index: int, offset: int) -> None:
+        self._packed = packed
+        self._index = index
+        self._offset = offset
+        self._extracted: Optional[Future] = None
+        self._type = None
+
+    def __str__(self) -> str:
+        return f"FutureSlice({self._packed}, {self._index})"
+
+    @property
+    def packed(self) -> Future:
+        return self._packed
+
+    @property
+    def offset(self) -> int:
+        return self._offset
+
+    @property
+    def handle(self) -> Any:
+        if self._extracted is None:
+            self._extracted = runtime.extract_scalar(self._packed, self._index)
+        return self._extracted.handle
+
+    @handle.setter
+    def handle(self, handle: Any) -> None:
+        raise ValueError("Future slices cannot be reassigned")
+
+    def same_handle(self, other: Future) -> bool:
+        return (
+            isinstance(other, FutureSlice)
+            and self._packed.same_handle(other._packed)
+            and self._index == other._index
+        )
+
+    def destroy(self, unordered: bool) -> None:
+        # The packed and extracted futures own their handles
+        pass
+
+    def get_buffer(self, size: Optional[int] = None) -> Any:
+        if size is None:
+            size = self.get_size()
+        ptr = legion.legion_future_get_untyped_pointer(self._packed.handle)
+        return ffi.buffer(ffi.cast("char *", ptr) + self._offset, size)
+
+    def get_size(self) -> int:
+        # The header holds the number of values followed by their sizes
+        offset = _sizeof_uint32 * (self._index + 1)
+        header = self._packed.get_buffer(offset + _sizeof_uint32)
+        return struct.unpack_from("I", header, offset)[0]
+
+    def get_string(self) -> bytes:
+        return self.get_buffer()[:]
+
+    def is_ready(self, subscribe: bool = False) -> bool:
+        return self._packed.is_ready(subscribe)
+
+    def wait(self) -> None:
+        self._packed.wait()
+
+
 class CommunicatorManager:
     def __init__(self, runtime: Runtime) -> None:
         self._runtime = runtime
@@ -1386,6 +1470,22 @@ class Runtime:
         launcher.add_scalar_arg(idx, ty.int32)
         return launcher.execute_single()
 
+    def slice_return_values(
+        self, future: Future, sizes: list[int]
+    ) -> list[Future]:
+        """
+        Returns views of the values packed in a future returned by a task.
+        The sizes of the values are given in order.
+        """
+        align = _RETURN_VALUE_ALIGNMENT
+        slices: list[Future] = []
+        offset = _sizeof_uint32 * (len(sizes) + 1)
+        for idx, size in enumerate(sizes):
+            offset = (offset + align - 1) // align * align
+            slices.append(FutureSlice(future, idx, offset))
+            offset += size
+        return slices
+
     def extract_scalar_with_domain(
         self, future: FutureMap, idx: int, launch_domain: Rect
     ) -> FutureMap:
@@ -1474,13 +1574,36 @@ class Runtime:
             Future.from_cdata(self.legion_runtime, wait_barrier),
         )
 
+    def fetch_error_message(
+        self, exception_id: int, node: int, point: int
+    ) -> Future:
+        from .launcher import TaskLauncher
+
+        launcher = TaskLauncher(
+            self.core_context,
+            self.core_library.LEGATE_CORE_FETCH_ERROR_MESSAGE_TASK_ID,
+            tag=self.core_library.LEGATE_CPU_VARIANT,
+        )
+        launcher.add_scalar_arg(exception_id, ty.uint64)
+        launcher.add_scalar_arg(point, ty.int64)
+        # The core mapper sends the task to the node given as its point
+        launcher.set_sharding_space(
+            self.find_or_create_index_space(Rect([self._num_nodes]))
+        )
+        launcher.set_point(Point([node]))
+        return launcher.execute_single()
+
     def record_pending_exception(
         self,
         exn_types: list[type],
-        future: Future,
+        status: Future,
+        exception_id: int,
         tb: Optional[TracebackType] = None,
     ) -> None:
-        exn = PendingException(exn_types, future, tb)
+        def fetch_error_message(node: int, point: int) -> Future:
+            return self.fetch_error_message(exception_id, node, point)
+
+        exn = PendingException(exn_types, status, fetch_error_message, tb)
         self._pending_exceptions.append(exn)
 
     def raise_exceptions(self) -> None:
@@ -598,7 +598,7 @@ class Storage:
 
     def set_data(self, data: Union[RegionField, Future]) -> None:
         assert (
-            self._kind is Future and type(data) is Future
+            self._kind is Future and isinstance(data, Future)
         ) or self._data is None
         self._data = data
 
@@ -201,11 +201,16 @@ list(APPEND legate_core_SOURCES
   src/core/runtime/projection.cc
   src/core/runtime/runtime.cc
   src/core/runtime/shard.cc
+  src/core/task/layout.cc
   src/core/task/return.cc
+  src/core/task/signature.cc
   src/core/task/task.cc
+  src/core/task/task_timer.cc
+  src/core/utilities/arena.cc
   src/core/utilities/debug.cc
   src/core/utilities/deserializer.cc
   src/core/utilities/machine.cc
+  src/core/utilities/nvtx_help.cc
   src/core/utilities/linearize.cc
 )
 
@@ -215,12 +220,24 @@ if(Legion_NETWORKS)
     src/core/comm/alltoallv_thread_mpi.cc
     src/core/comm/gather_thread_mpi.cc
     src/core/comm/allgather_thread_mpi.cc
-    src/core/comm/bcast_thread_mpi.cc)
+    src/core/comm/allgatherv_thread_mpi.cc
+    src/core/comm/bcast_thread_mpi.cc
+    src/core/comm/allreduce_thread_mpi.cc
+    src/core/comm/reduce_thread_mpi.cc
+    src/core/comm/reduce_scatter_thread_mpi.cc
+    src/core/comm/nonblocking_thread_mpi.cc)
 else()
   list(APPEND legate_core_SOURCES
     src/core/comm/alltoall_thread_local.cc
     src/core/comm/alltoallv_thread_local.cc
-    src/core/comm/allgather_thread_local.cc)
+    src/core/comm/allgather_thread_local.cc
+    src/core/comm/allgatherv_thread_local.cc
+    src/core/comm/bcast_thread_local.cc
+    src/core/comm/gather_thread_local.cc
+    src/core/comm/allreduce_thread_local.cc
+    src/core/comm/reduce_thread_local.cc
+    src/core/comm/reduce_scatter_thread_local.cc
+    src/core/comm/nonblocking_thread_local.cc)
 endif()
 
 if(Legion_USE_CUDA)
@@ -284,6 +301,49 @@ target_include_directories(legate_core
     $<INSTALL_INTERFACE:include/legate>
 )
 
+if(legate_core_BUILD_COLL_BENCH)
+  find_package(Threads REQUIRED)
+  add_executable(coll_bench src/core/comm/bench/coll_bench.cc)
+  set_target_properties(coll_bench
+             PROPERTIES BUILD_RPATH                         "\$ORIGIN/../lib"
+                        CXX_STANDARD                        17
+                        CXX_STANDARD_REQUIRED               ON
+                        RUNTIME_OUTPUT_DIRECTORY            bin)
+  target_link_libraries(coll_bench
+    PRIVATE legate_core
+            Threads::Threads
+            $<TARGET_NAME_IF_EXISTS:MPI::MPI_CXX>)
+endif()
+
+if(legate_core_BUILD_COLL_TESTS)
+  find_package(Threads REQUIRED)
+  enable_testing()
+  set(coll_tests coll_reduction_test)
+  # The tags only exist in the network backend
+  if(Legion_NETWORKS)
+    list(APPEND coll_tests coll_tag_test)
+  endif()
+  foreach(test IN LISTS coll_tests)
+    add_executable(${test} src/core/comm/tests/${test}.cc)
+    set_target_properties(${test}
+               PROPERTIES BUILD_RPATH                         "\$ORIGIN/../lib"
+                          CXX_STANDARD                        17
+                          CXX_STANDARD_REQUIRED               ON
+                          RUNTIME_OUTPUT_DIRECTORY            bin)
+    target_link_libraries(${test}
+      PRIVATE legate_core
+              Threads::Threads
+              $<TARGET_NAME_IF_EXISTS:MPI::MPI_CXX>)
+    add_test(NAME ${test} COMMAND ${test})
+  endforeach()
+  # With the network backend, the ranks are also spread over two processes
+  if(Legion_NETWORKS)
+    add_test(NAME coll_reduction_test_mpi
+             COMMAND ${MPIEXEC_EXECUTABLE} ${MPIEXEC_NUMPROC_FLAG} 2 ${MPIEXEC_PREFLAGS}
+                     $<TARGET_FILE:coll_reduction_test> ${MPIEXEC_POSTFLAGS})
+  endif()
+endif()
+
 if(Legion_USE_CUDA)
   file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/fatbin.ld"
           [=[
@@ -354,18 +414,23 @@ install(
 
 install(
   FILES src/core/task/exception.h
+        src/core/task/layout.h
         src/core/task/return.h
+        src/core/task/signature.h
         src/core/task/task.h
+        src/core/task/task_timer.h
   DESTINATION ${CMAKE_INSTALL_INCLUDEDIR}/legate/core/task)
 
 install(
-  FILES src/core/utilities/debug.h
+  FILES src/core/utilities/arena.h
+        src/core/utilities/debug.h
         src/core/utilities/deserializer.h
         src/core/utilities/deserializer.inl
         src/core/utilities/dispatch.h
         src/core/utilities/machine.h
         src/core/utilities/nvtx_help.h
         src/core/utilities/span.h
+        src/core/utilities/strided_view.h
         src/core/utilities/type_traits.h
         src/core/utilities/typedefs.h
   DESTINATION ${CMAKE_INSTALL_INCLUDEDIR}/legate/core/utilities)
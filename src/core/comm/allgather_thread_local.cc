@@ -30,7 +30,7 @@ using namespace Legion;
 extern Logger log_coll;
 
 int allgatherLocal(
-  const void* sendbuf, void* recvbuf, int count, CollDataType type, CollComm global_comm)
+  const void* sendbuf, void* recvbuf, int64_t count, CollDataType type, CollComm global_comm)
 {
   int total_size  = global_comm->global_comm_size;
   int global_rank = global_comm->global_rank;
@@ -42,14 +42,12 @@ int allgatherLocal(
   // MPI_IN_PLACE
   if (sendbuf == recvbuf) { sendbuf_tmp = allocateInplaceBuffer(recvbuf, type_extent * count); }
 
-  global_comm->comm->buffers[global_rank] = sendbuf_tmp;
-  __sync_synchronize();
+  publishLocalBuffer(global_comm, sendbuf_tmp);
 
   for (int recvfrom_global_rank = 0; recvfrom_global_rank < total_size; recvfrom_global_rank++) {
     // wait for other threads to update the buffer address
-    while (global_comm->comm->buffers[recvfrom_global_rank] == nullptr)
-      ;
-    const void* src = global_comm->comm->buffers[recvfrom_global_rank];
+    waitLocal(global_comm, recvfrom_global_rank);
+    const void* src = global_comm->comm->slots[recvfrom_global_rank].buffer;
     char* dst       = static_cast<char*>(recvbuf) +
                 static_cast<ptrdiff_t>(recvfrom_global_rank) * type_extent * count;
 #ifdef DEBUG_LEGATE
@@ -66,14 +64,10 @@ int allgatherLocal(
     memcpy(dst, src, count * type_extent);
   }
 
+  // Keep the published buffer alive until every peer is done reading from it
   barrierLocal(global_comm);
   if (sendbuf == recvbuf) { free(const_cast<void*>(sendbuf_tmp)); }
 
-  __sync_synchronize();
-
-  resetLocalBuffer(global_comm);
-  barrierLocal(global_comm);
-
   return CollSuccess;
 }
 
@@ -26,7 +26,7 @@ namespace comm {
 namespace coll {
 
 int allgatherMPI(
-  const void* sendbuf, void* recvbuf, int count, CollDataType type, CollComm global_comm)
+  const void* sendbuf, void* recvbuf, int64_t count, CollDataType type, CollComm global_comm)
 {
   int total_size  = global_comm->global_comm_size;
   int global_rank = global_comm->global_rank;
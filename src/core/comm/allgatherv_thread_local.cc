@@ -0,0 +1,85 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "coll.h"
+#include "legion.h"
+
+namespace legate {
+namespace comm {
+namespace coll {
+
+using namespace Legion;
+extern Logger log_coll;
+
+// Ranks sharing the address space copy each block straight out of its owner's buffer, so there
+// is a single round whatever the size of the contributions
+int allgathervLocal(const void* sendbuf,
+                    int64_t sendcount,
+                    void* recvbuf,
+                    const int64_t recvcounts[],
+                    const int64_t displs[],
+                    CollDataType type,
+                    CollComm global_comm)
+{
+  int total_size  = global_comm->global_comm_size;
+  int global_rank = global_comm->global_rank;
+
+  size_t type_extent = getDtypeSize(type);
+
+  // IN_PLACE: peers read our block out of recvbuf, which we do not write
+  const void* own_block =
+    sendbuf == recvbuf
+      ? static_cast<const char*>(recvbuf) + static_cast<ptrdiff_t>(displs[global_rank]) * type_extent
+      : sendbuf;
+
+  publishLocalBuffer(global_comm, own_block);
+
+  for (int i = 0; i < total_size; i++) {
+    int recvfrom_global_rank = (global_rank + i) % total_size;
+    if (recvfrom_global_rank == global_rank && sendbuf == recvbuf) { continue; }
+    // wait for other threads to update the buffer address
+    waitLocal(global_comm, recvfrom_global_rank);
+    const void* src = global_comm->comm->slots[recvfrom_global_rank].buffer;
+    char* dst       = static_cast<char*>(recvbuf) +
+                static_cast<ptrdiff_t>(displs[recvfrom_global_rank]) * type_extent;
+#ifdef DEBUG_LEGATE
+    log_coll.debug(
+      "AllgathervLocal i: %d === global_rank %d, dtype %zu, copy rank %d (%p) to rank %d (%p)",
+      i,
+      global_rank,
+      type_extent,
+      recvfrom_global_rank,
+      src,
+      global_rank,
+      dst);
+#endif
+    memcpy(dst, src, recvcounts[recvfrom_global_rank] * type_extent);
+  }
+
+  // Keep the published buffer alive until every peer is done reading from it
+  barrierLocal(global_comm);
+
+  return CollSuccess;
+}
+
+}  // namespace coll
+}  // namespace comm
+}  // namespace legate
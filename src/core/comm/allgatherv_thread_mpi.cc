@@ -0,0 +1,323 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "coll.h"
+#include "legion.h"
+
+namespace legate {
+namespace comm {
+namespace coll {
+
+using namespace Legion;
+extern Logger log_coll;
+
+// Payloads up to this size use recursive doubling (log(p) latency-bound rounds), larger ones
+// use the ring, which moves each block across every link exactly once
+static constexpr size_t ALLGATHERV_RING_THRESHOLD = 64 << 10;
+
+// Describes the blocks of recvbuf that belong to the ranks in [first, last), except skip, as a
+// single datatype, so that a whole range of blocks moves in one message
+static MPI_Datatype createBlocksType(const int64_t recvcounts[],
+                                     const int64_t displs[],
+                                     int first,
+                                     int last,
+                                     int skip,
+                                     MPI_Datatype mpi_type,
+                                     MPI_Aint type_extent)
+{
+  std::vector<int> lengths;
+  std::vector<MPI_Aint> offsets;
+  for (int i = first; i < last; i++) {
+    if (i == skip || recvcounts[i] == 0) { continue; }
+    lengths.push_back(static_cast<int>(recvcounts[i]));
+    offsets.push_back(static_cast<MPI_Aint>(displs[i]) * type_extent);
+  }
+  MPI_Datatype blocks_type;
+  CHECK_MPI(MPI_Type_create_hindexed(
+    lengths.size(), lengths.data(), offsets.data(), mpi_type, &blocks_type));
+  CHECK_MPI(MPI_Type_commit(&blocks_type));
+  return blocks_type;
+}
+
+// Sends the blocks of the ranks in [send_first, send_last) to peer and receives those of the
+// ranks in [recv_first, recv_last) from it, leaving out the block of skip. Either range can be
+// empty for a one-sided transfer.
+static void exchangeBlocks(void* recvbuf,
+                           const int64_t recvcounts[],
+                           const int64_t displs[],
+                           int send_first,
+                           int send_last,
+                           int recv_first,
+                           int recv_last,
+                           int skip,
+                           int peer,
+                           MPI_Datatype mpi_type,
+                           MPI_Aint type_extent,
+                           CollComm global_comm)
+{
+  int global_rank   = global_comm->global_rank;
+  int peer_mpi_rank = global_comm->mapping_table.mpi_rank[peer];
+  MPI_Datatype send_type =
+    createBlocksType(recvcounts, displs, send_first, send_last, skip, mpi_type, type_extent);
+  MPI_Datatype recv_type =
+    createBlocksType(recvcounts, displs, recv_first, recv_last, skip, mpi_type, type_extent);
+  int send_tag = generateAllgathervTag(peer, global_rank, global_comm);
+  int recv_tag = generateAllgathervTag(global_rank, peer, global_comm);
+#ifdef DEBUG_LEGATE
+  log_coll.debug(
+    "AllgathervMPI recursive doubling === global_rank %d, mpi rank %d, send blocks [%d, %d) to "
+    "%d (%d), recv blocks [%d, %d), send_tag %d, recv_tag %d",
+    global_rank,
+    global_comm->mpi_rank,
+    send_first,
+    send_last,
+    peer,
+    peer_mpi_rank,
+    recv_first,
+    recv_last,
+    send_tag,
+    recv_tag);
+#endif
+  if (send_first == send_last) {
+    CHECK_MPI_WAIT(MPI_Recv(
+      recvbuf, 1, recv_type, peer_mpi_rank, recv_tag, global_comm->comm, MPI_STATUS_IGNORE));
+  } else if (recv_first == recv_last) {
+    CHECK_MPI_WAIT(MPI_Send(recvbuf, 1, send_type, peer_mpi_rank, send_tag, global_comm->comm));
+  } else {
+    CHECK_MPI_WAIT(MPI_Sendrecv(recvbuf,
+                                1,
+                                send_type,
+                                peer_mpi_rank,
+                                send_tag,
+                                recvbuf,
+                                1,
+                                recv_type,
+                                peer_mpi_rank,
+                                recv_tag,
+                                global_comm->comm,
+                                MPI_STATUS_IGNORE));
+  }
+  CHECK_MPI(MPI_Type_free(&send_type));
+  CHECK_MPI(MPI_Type_free(&recv_type));
+}
+
+static int allgathervRecursiveDoubling(void* recvbuf,
+                                       const int64_t recvcounts[],
+                                       const int64_t displs[],
+                                       MPI_Datatype mpi_type,
+                                       MPI_Aint type_extent,
+                                       CollComm global_comm)
+{
+  int total_size  = global_comm->global_comm_size;
+  int global_rank = global_comm->global_rank;
+
+  // Fold the ranks beyond the largest power of two into their odd neighbors first. Virtual rank
+  // r then holds the blocks of the ranks in [first_rank(r), first_rank(r + 1)), so any aligned
+  // group of virtual ranks covers a contiguous range of ranks.
+  int pof2 = 1;
+  while (pof2 * 2 <= total_size) pof2 *= 2;
+  int rem = total_size - pof2;
+
+  auto first_rank = [&](int new_rank) { return new_rank < rem ? 2 * new_rank : new_rank + rem; };
+
+  int new_rank;
+  if (global_rank < 2 * rem) {
+    if (global_rank % 2 == 0) {
+      exchangeBlocks(recvbuf,
+                     recvcounts,
+                     displs,
+                     global_rank,
+                     global_rank + 1,
+                     0,
+                     0,
+                     -1,
+                     global_rank + 1,
+                     mpi_type,
+                     type_extent,
+                     global_comm);
+      new_rank = -1;
+    } else {
+      exchangeBlocks(recvbuf,
+                     recvcounts,
+                     displs,
+                     0,
+                     0,
+                     global_rank - 1,
+                     global_rank,
+                     -1,
+                     global_rank - 1,
+                     mpi_type,
+                     type_extent,
+                     global_comm);
+      new_rank = global_rank / 2;
+    }
+  } else {
+    new_rank = global_rank - rem;
+  }
+
+  if (new_rank != -1) {
+    for (int mask = 1; mask < pof2; mask <<= 1) {
+      int new_peer  = new_rank ^ mask;
+      int peer      = new_peer < rem ? new_peer * 2 + 1 : new_peer + rem;
+      int own_base  = new_rank & ~(mask - 1);
+      int peer_base = new_peer & ~(mask - 1);
+      exchangeBlocks(recvbuf,
+                     recvcounts,
+                     displs,
+                     first_rank(own_base),
+                     first_rank(own_base + mask),
+                     first_rank(peer_base),
+                     first_rank(peer_base + mask),
+                     -1,
+                     peer,
+                     mpi_type,
+                     type_extent,
+                     global_comm);
+    }
+  }
+
+  // Hand everything but their own block back to the ranks folded away in the first step
+  if (global_rank < 2 * rem) {
+    if (global_rank % 2 == 1) {
+      exchangeBlocks(recvbuf,
+                     recvcounts,
+                     displs,
+                     0,
+                     total_size,
+                     0,
+                     0,
+                     global_rank - 1,
+                     global_rank - 1,
+                     mpi_type,
+                     type_extent,
+                     global_comm);
+    } else {
+      exchangeBlocks(recvbuf,
+                     recvcounts,
+                     displs,
+                     0,
+                     0,
+                     0,
+                     total_size,
+                     global_rank,
+                     global_rank + 1,
+                     mpi_type,
+                     type_extent,
+                     global_comm);
+    }
+  }
+
+  return CollSuccess;
+}
+
+static int allgathervRing(void* recvbuf,
+                          const int64_t recvcounts[],
+                          const int64_t displs[],
+                          MPI_Datatype mpi_type,
+                          MPI_Aint type_extent,
+                          CollComm global_comm)
+{
+  int total_size  = global_comm->global_comm_size;
+  int global_rank = global_comm->global_rank;
+
+  int sendto_global_rank   = (global_rank + 1) % total_size;
+  int recvfrom_global_rank = (global_rank + total_size - 1) % total_size;
+  int sendto_mpi_rank      = global_comm->mapping_table.mpi_rank[sendto_global_rank];
+  int recvfrom_mpi_rank    = global_comm->mapping_table.mpi_rank[recvfrom_global_rank];
+  int send_tag             = generateAllgathervTag(sendto_global_rank, global_rank, global_comm);
+  int recv_tag = generateAllgathervTag(global_rank, recvfrom_global_rank, global_comm);
+
+  auto block_ptr = [&](int block) {
+    return static_cast<char*>(recvbuf) + static_cast<ptrdiff_t>(displs[block]) * type_extent;
+  };
+
+  // In step i, forward the block received in step i - 1, starting with our own
+  for (int i = 0; i < total_size - 1; i++) {
+    int send_block = (global_rank + total_size - i) % total_size;
+    int recv_block = (global_rank + total_size - i - 1) % total_size;
+#ifdef DEBUG_LEGATE
+    log_coll.debug(
+      "AllgathervMPI ring i: %d === global_rank %d, mpi rank %d, send block %d to %d (%d), recv "
+      "block %d from %d (%d)",
+      i,
+      global_rank,
+      global_comm->mpi_rank,
+      send_block,
+      sendto_global_rank,
+      sendto_mpi_rank,
+      recv_block,
+      recvfrom_global_rank,
+      recvfrom_mpi_rank);
+#endif
+    sendrecvLarge(block_ptr(send_block),
+                  recvcounts[send_block],
+                  sendto_mpi_rank,
+                  send_tag,
+                  block_ptr(recv_block),
+                  recvcounts[recv_block],
+                  recvfrom_mpi_rank,
+                  recv_tag,
+                  mpi_type,
+                  global_comm->comm);
+  }
+
+  return CollSuccess;
+}
+
+int allgathervMPI(const void* sendbuf,
+                  int64_t sendcount,
+                  void* recvbuf,
+                  const int64_t recvcounts[],
+                  const int64_t displs[],
+                  CollDataType type,
+                  CollComm global_comm)
+{
+  int total_size  = global_comm->global_comm_size;
+  int global_rank = global_comm->global_rank;
+
+  MPI_Datatype mpi_type = dtypeToMPIDtype(type);
+
+  MPI_Aint lb, type_extent;
+  MPI_Type_get_extent(mpi_type, &lb, &type_extent);
+
+  // Both algorithms work within recvbuf, so our own block goes there first unless it already is
+  if (sendbuf != recvbuf) {
+    memcpy(static_cast<char*>(recvbuf) + static_cast<ptrdiff_t>(displs[global_rank]) * type_extent,
+           sendbuf,
+           type_extent * static_cast<size_t>(sendcount));
+  }
+
+  if (total_size == 1) { return CollSuccess; }
+
+  size_t bytes = 0;
+  for (int i = 0; i < total_size; i++) { bytes += type_extent * static_cast<size_t>(recvcounts[i]); }
+  if (bytes <= ALLGATHERV_RING_THRESHOLD) {
+    return allgathervRecursiveDoubling(
+      recvbuf, recvcounts, displs, mpi_type, type_extent, global_comm);
+  } else {
+    return allgathervRing(recvbuf, recvcounts, displs, mpi_type, type_extent, global_comm);
+  }
+}
+
+}  // namespace coll
+}  // namespace comm
+}  // namespace legate
@@ -0,0 +1,100 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "coll.h"
+#include "legion.h"
+
+namespace legate {
+namespace comm {
+namespace coll {
+
+using namespace Legion;
+extern Logger log_coll;
+
+
+int allreduceLocal(const void* sendbuf,
+                   void* recvbuf,
+                   int count,
+                   CollDataType type,
+                   CollReductionOp op,
+                   CollComm global_comm)
+{
+  int total_size  = global_comm->global_comm_size;
+  int global_rank = global_comm->global_rank;
+
+  size_t type_extent = getDtypeSize(type);
+
+  // Every rank publishes a copy of its contribution in its own recvbuf. Rank r then owns
+  // segment r of the result and reduces it in place across all ranks' recvbufs; each
+  // segment is written only by its owner, so no other rank reads what is being updated.
+  if (sendbuf != recvbuf) { memcpy(recvbuf, sendbuf, count * type_extent); }
+
+  publishLocalBuffer(global_comm, recvbuf);
+
+  size_t seg_start = static_cast<size_t>(count) * global_rank / total_size;
+  size_t seg_end   = static_cast<size_t>(count) * (global_rank + 1) / total_size;
+  char* dst        = static_cast<char*>(recvbuf) + seg_start * type_extent;
+  for (int i = 1; i < total_size; i++) {
+    int recvfrom_global_rank = (global_rank + i) % total_size;
+    waitLocal(global_comm, recvfrom_global_rank);
+    const char* src =
+      static_cast<const char*>(global_comm->comm->slots[recvfrom_global_rank].buffer) +
+      seg_start * type_extent;
+#ifdef DEBUG_LEGATE
+    log_coll.debug(
+      "AllreduceLocal i: %d === global_rank %d, dtype %zu, reduce rank %d (%p) into seg [%zu, "
+      "%zu) (%p)",
+      i,
+      global_rank,
+      type_extent,
+      recvfrom_global_rank,
+      src,
+      seg_start,
+      seg_end,
+      dst);
+#endif
+    applyReduction(dst, src, seg_end - seg_start, type, op);
+  }
+
+  // Announce that our segment of the result is final
+  signalLocal(global_comm);
+
+  // Fetch the segments owned by the other ranks
+  for (int i = 1; i < total_size; i++) {
+    int recvfrom_global_rank = (global_rank + i) % total_size;
+    size_t start = static_cast<size_t>(count) * recvfrom_global_rank / total_size;
+    size_t end   = static_cast<size_t>(count) * (recvfrom_global_rank + 1) / total_size;
+    waitLocal(global_comm, recvfrom_global_rank);
+    const char* src =
+      static_cast<const char*>(global_comm->comm->slots[recvfrom_global_rank].buffer) +
+      start * type_extent;
+    memcpy(static_cast<char*>(recvbuf) + start * type_extent, src, (end - start) * type_extent);
+  }
+
+  // Keep the published buffer alive until every peer is done reading from it
+  barrierLocal(global_comm);
+
+  return CollSuccess;
+}
+
+}  // namespace coll
+}  // namespace comm
+}  // namespace legate
@@ -0,0 +1,264 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+#include "coll.h"
+#include "legion.h"
+
+namespace legate {
+namespace comm {
+namespace coll {
+
+using namespace Legion;
+extern Logger log_coll;
+
+// Payloads up to this size use recursive doubling (log(p) latency-bound rounds), larger ones
+// use the bandwidth-optimal ring (reduce-scatter followed by allgather)
+static constexpr size_t ALLREDUCE_RING_THRESHOLD = 64 << 10;
+
+static int allreduceRecursiveDoubling(void* recvbuf,
+                                      int count,
+                                      MPI_Datatype mpi_type,
+                                      MPI_Aint type_extent,
+                                      CollDataType type,
+                                      CollReductionOp op,
+                                      CollComm global_comm)
+{
+  MPI_Status status;
+
+  int total_size  = global_comm->global_comm_size;
+  int global_rank = global_comm->global_rank;
+
+  void* tmp = malloc(type_extent * static_cast<size_t>(count));
+  assert(tmp != nullptr);
+
+  // Fold the ranks beyond the largest power of two into their even neighbors first
+  int pof2 = 1;
+  while (pof2 * 2 <= total_size) pof2 *= 2;
+  int rem = total_size - pof2;
+
+  int new_rank;
+  if (global_rank < 2 * rem) {
+    if (global_rank % 2 == 0) {
+      int peer = global_rank + 1;
+      CHECK_MPI_WAIT(MPI_Send(recvbuf,
+                              count,
+                              mpi_type,
+                              global_comm->mapping_table.mpi_rank[peer],
+                              generateAllreduceTag(peer, global_rank, global_comm),
+                              global_comm->comm));
+      new_rank = -1;
+    } else {
+      int peer = global_rank - 1;
+      CHECK_MPI_WAIT(MPI_Recv(tmp,
+                              count,
+                              mpi_type,
+                              global_comm->mapping_table.mpi_rank[peer],
+                              generateAllreduceTag(global_rank, peer, global_comm),
+                              global_comm->comm,
+                              &status));
+      applyReduction(recvbuf, tmp, count, type, op);
+      new_rank = global_rank / 2;
+    }
+  } else {
+    new_rank = global_rank - rem;
+  }
+
+  if (new_rank != -1) {
+    for (int mask = 1; mask < pof2; mask <<= 1) {
+      int new_peer = new_rank ^ mask;
+      int peer     = new_peer < rem ? new_peer * 2 + 1 : new_peer + rem;
+      int peer_mpi_rank = global_comm->mapping_table.mpi_rank[peer];
+      int send_tag      = generateAllreduceTag(peer, global_rank, global_comm);
+      int recv_tag      = generateAllreduceTag(global_rank, peer, global_comm);
+#ifdef DEBUG_LEGATE
+      log_coll.debug(
+        "AllreduceMPI recursive doubling mask: %d === global_rank %d, mpi rank %d, exchange with "
+        "%d (%d), send_tag %d, recv_tag %d",
+        mask,
+        global_rank,
+        global_comm->mpi_rank,
+        peer,
+        peer_mpi_rank,
+        send_tag,
+        recv_tag);
+#endif
+      CHECK_MPI_WAIT(MPI_Sendrecv(recvbuf,
+                                  count,
+                                  mpi_type,
+                                  peer_mpi_rank,
+                                  send_tag,
+                                  tmp,
+                                  count,
+                                  mpi_type,
+                                  peer_mpi_rank,
+                                  recv_tag,
+                                  global_comm->comm,
+                                  &status));
+      applyReduction(recvbuf, tmp, count, type, op);
+    }
+  }
+
+  // Hand the result back to the ranks folded away in the first step
+  if (global_rank < 2 * rem) {
+    if (global_rank % 2 == 1) {
+      int peer = global_rank - 1;
+      CHECK_MPI_WAIT(MPI_Send(recvbuf,
+                              count,
+                              mpi_type,
+                              global_comm->mapping_table.mpi_rank[peer],
+                              generateAllreduceTag(peer, global_rank, global_comm),
+                              global_comm->comm));
+    } else {
+      int peer = global_rank + 1;
+      CHECK_MPI_WAIT(MPI_Recv(recvbuf,
+                              count,
+                              mpi_type,
+                              global_comm->mapping_table.mpi_rank[peer],
+                              generateAllreduceTag(global_rank, peer, global_comm),
+                              global_comm->comm,
+                              &status));
+    }
+  }
+
+  free(tmp);
+
+  return CollSuccess;
+}
+
+static int allreduceRing(void* recvbuf,
+                         int count,
+                         MPI_Datatype mpi_type,
+                         MPI_Aint type_extent,
+                         CollDataType type,
+                         CollReductionOp op,
+                         CollComm global_comm)
+{
+  MPI_Status status;
+
+  int total_size  = global_comm->global_comm_size;
+  int global_rank = global_comm->global_rank;
+
+  int sendto_global_rank   = (global_rank + 1) % total_size;
+  int recvfrom_global_rank = (global_rank + total_size - 1) % total_size;
+  int sendto_mpi_rank      = global_comm->mapping_table.mpi_rank[sendto_global_rank];
+  int recvfrom_mpi_rank    = global_comm->mapping_table.mpi_rank[recvfrom_global_rank];
+  int send_tag             = generateAllreduceTag(sendto_global_rank, global_rank, global_comm);
+  int recv_tag             = generateAllreduceTag(global_rank, recvfrom_global_rank, global_comm);
+
+  auto seg_start = [&](int seg) {
+    return static_cast<int>(static_cast<int64_t>(count) * seg / total_size);
+  };
+  auto seg_count = [&](int seg) { return seg_start(seg + 1) - seg_start(seg); };
+  auto seg_ptr   = [&](int seg) {
+    return static_cast<char*>(recvbuf) + static_cast<ptrdiff_t>(seg_start(seg)) * type_extent;
+  };
+
+  void* tmp = malloc(type_extent * static_cast<size_t>(seg_count(total_size - 1)));
+  assert(tmp != nullptr);
+
+  // Reduce-scatter: after total_size - 1 steps, this rank owns segment (global_rank + 1)
+  for (int i = 0; i < total_size - 1; i++) {
+    int send_seg = (global_rank + total_size - i) % total_size;
+    int recv_seg = (global_rank + total_size - i - 1) % total_size;
+#ifdef DEBUG_LEGATE
+    log_coll.debug(
+      "AllreduceMPI ring reduce-scatter i: %d === global_rank %d, mpi rank %d, send seg %d to %d "
+      "(%d), recv seg %d from %d (%d)",
+      i,
+      global_rank,
+      global_comm->mpi_rank,
+      send_seg,
+      sendto_global_rank,
+      sendto_mpi_rank,
+      recv_seg,
+      recvfrom_global_rank,
+      recvfrom_mpi_rank);
+#endif
+    CHECK_MPI_WAIT(MPI_Sendrecv(seg_ptr(send_seg),
+                                seg_count(send_seg),
+                                mpi_type,
+                                sendto_mpi_rank,
+                                send_tag,
+                                tmp,
+                                seg_count(recv_seg),
+                                mpi_type,
+                                recvfrom_mpi_rank,
+                                recv_tag,
+                                global_comm->comm,
+                                &status));
+    applyReduction(seg_ptr(recv_seg), tmp, seg_count(recv_seg), type, op);
+  }
+
+  // Allgather: circulate the reduced segments around the ring
+  for (int i = 0; i < total_size - 1; i++) {
+    int send_seg = (global_rank + total_size - i + 1) % total_size;
+    int recv_seg = (global_rank + total_size - i) % total_size;
+    CHECK_MPI_WAIT(MPI_Sendrecv(seg_ptr(send_seg),
+                                seg_count(send_seg),
+                                mpi_type,
+                                sendto_mpi_rank,
+                                send_tag,
+                                seg_ptr(recv_seg),
+                                seg_count(recv_seg),
+                                mpi_type,
+                                recvfrom_mpi_rank,
+                                recv_tag,
+                                global_comm->comm,
+                                &status));
+  }
+
+  free(tmp);
+
+  return CollSuccess;
+}
+
+int allreduceMPI(const void* sendbuf,
+                 void* recvbuf,
+                 int count,
+                 CollDataType type,
+                 CollReductionOp op,
+                 CollComm global_comm)
+{
+  int total_size = global_comm->global_comm_size;
+
+  MPI_Datatype mpi_type = dtypeToMPIDtype(type);
+
+  MPI_Aint lb, type_extent;
+  MPI_Type_get_extent(mpi_type, &lb, &type_extent);
+
+  if (sendbuf != recvbuf) {
+    memcpy(recvbuf, sendbuf, type_extent * static_cast<size_t>(count));
+  }
+
+  if (total_size == 1) { return CollSuccess; }
+
+  size_t bytes = type_extent * static_cast<size_t>(count);
+  if (bytes <= ALLREDUCE_RING_THRESHOLD || count < total_size) {
+    return allreduceRecursiveDoubling(recvbuf, count, mpi_type, type_extent, type, op, global_comm);
+  } else {
+    return allreduceRing(recvbuf, count, mpi_type, type_extent, type, op, global_comm);
+  }
+}
+
+}  // namespace coll
+}  // namespace comm
+}  // namespace legate
@@ -30,7 +30,7 @@ using namespace Legion;
 extern Logger log_coll;
 
 int alltoallLocal(
-  const void* sendbuf, void* recvbuf, int count, CollDataType type, CollComm global_comm)
+  const void* sendbuf, void* recvbuf, int64_t count, CollDataType type, CollComm global_comm)
 {
   int res;
 
@@ -39,8 +39,7 @@ int alltoallLocal(
 
   int type_extent = getDtypeSize(type);
 
-  global_comm->comm->buffers[global_rank] = sendbuf;
-  __sync_synchronize();
+  publishLocalBuffer(global_comm, sendbuf);
 
   int recvfrom_global_rank;
   int recvfrom_seg_id  = global_rank;
@@ -48,9 +47,8 @@ int alltoallLocal(
   for (int i = 1; i < total_size + 1; i++) {
     recvfrom_global_rank = (global_rank + total_size - i) % total_size;
     // wait for other threads to update the buffer address
-    while (global_comm->comm->buffers[recvfrom_global_rank] == nullptr)
-      ;
-    src_base  = global_comm->comm->buffers[recvfrom_global_rank];
+    waitLocal(global_comm, recvfrom_global_rank);
+    src_base  = global_comm->comm->slots[recvfrom_global_rank].buffer;
     char* src = static_cast<char*>(const_cast<void*>(src_base)) +
                 static_cast<ptrdiff_t>(recvfrom_seg_id) * type_extent * count;
     char* dst = static_cast<char*>(recvbuf) +
@@ -72,11 +70,7 @@ int alltoallLocal(
     memcpy(dst, src, count * type_extent);
   }
 
-  barrierLocal(global_comm);
-
-  __sync_synchronize();
-
-  resetLocalBuffer(global_comm);
+  // Keep the published buffer alive until every peer is done reading from it
   barrierLocal(global_comm);
 
   return CollSuccess;
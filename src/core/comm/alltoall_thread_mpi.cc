@@ -20,6 +20,7 @@
 #include <string.h>
 
 #include "coll.h"
+#include "legate.h"
 #include "legion.h"
 
 namespace legate {
@@ -29,11 +30,97 @@ namespace coll {
 using namespace Legion;
 extern Logger log_coll;
 
-int alltoallMPI(
-  const void* sendbuf, void* recvbuf, int count, CollDataType type, CollComm global_comm)
+// Blocks up to this many bytes per peer are exchanged with Bruck's algorithm, larger ones
+// pairwise. Can be overridden with LEGATE_COLL_ALLTOALL_BRUCK_THRESHOLD.
+static constexpr uint32_t ALLTOALL_BRUCK_THRESHOLD = 256;
+
+// Bruck's algorithm: log(p) rounds instead of p, each moving about half of the blocks, which
+// pays off when the exchange is latency bound
+static int alltoallBruck(const void* sendbuf,
+                         void* recvbuf,
+                         int64_t count,
+                         MPI_Datatype mpi_type,
+                         MPI_Aint type_extent,
+                         CollComm global_comm)
 {
-  MPI_Status status;
+  int total_size  = global_comm->global_comm_size;
+  int global_rank = global_comm->global_rank;
+
+  size_t block_size = type_extent * static_cast<size_t>(count);
+  char* tmp         = static_cast<char*>(malloc(block_size * total_size));
+  char* pack        = static_cast<char*>(malloc(block_size * ((total_size + 1) / 2)));
+  char* unpack      = static_cast<char*>(malloc(block_size * ((total_size + 1) / 2)));
+  assert(tmp != nullptr && pack != nullptr && unpack != nullptr);
+
+  // Rotate the blocks so that block i is the one destined to the rank i places further
+  for (int i = 0; i < total_size; i++) {
+    memcpy(tmp + i * block_size,
+           static_cast<const char*>(sendbuf) + ((global_rank + i) % total_size) * block_size,
+           block_size);
+  }
+
+  // In round k, every block whose index has bit k set moves 2^k ranks forward
+  for (int mask = 1; mask < total_size; mask <<= 1) {
+    int sendto_global_rank   = (global_rank + mask) % total_size;
+    int recvfrom_global_rank = (global_rank + total_size - mask) % total_size;
+    int sendto_mpi_rank      = global_comm->mapping_table.mpi_rank[sendto_global_rank];
+    int recvfrom_mpi_rank    = global_comm->mapping_table.mpi_rank[recvfrom_global_rank];
+
+    int send_tag = generateAlltoallTag(sendto_global_rank, global_rank, global_comm);
+    int recv_tag = generateAlltoallTag(global_rank, recvfrom_global_rank, global_comm);
+
+    int64_t nb_blocks = 0;
+    for (int i = mask; i < total_size; i++) {
+      if (i & mask) { memcpy(pack + nb_blocks++ * block_size, tmp + i * block_size, block_size); }
+    }
+#ifdef DEBUG_LEGATE
+    log_coll.debug(
+      "AlltoallMPI Bruck mask: %d === global_rank %d, mpi rank %d, send to %d (%d), send_tag %d, "
+      "recv from %d (%d), recv_tag %d, blocks %lld",
+      mask,
+      global_rank,
+      global_comm->mpi_rank,
+      sendto_global_rank,
+      sendto_mpi_rank,
+      send_tag,
+      recvfrom_global_rank,
+      recvfrom_mpi_rank,
+      recv_tag,
+      static_cast<long long>(nb_blocks));
+#endif
+    sendrecvLarge(pack,
+                  nb_blocks * count,
+                  sendto_mpi_rank,
+                  send_tag,
+                  unpack,
+                  nb_blocks * count,
+                  recvfrom_mpi_rank,
+                  recv_tag,
+                  mpi_type,
+                  global_comm->comm);
+    nb_blocks = 0;
+    for (int i = mask; i < total_size; i++) {
+      if (i & mask) { memcpy(tmp + i * block_size, unpack + nb_blocks++ * block_size, block_size); }
+    }
+  }
+
+  // Block i now holds the data of the rank i places back
+  for (int i = 0; i < total_size; i++) {
+    memcpy(static_cast<char*>(recvbuf) +
+             ((global_rank + total_size - i) % total_size) * block_size,
+           tmp + i * block_size,
+           block_size);
+  }
+
+  free(tmp);
+  free(pack);
+  free(unpack);
+  return CollSuccess;
+}
 
+int alltoallMPI(
+  const void* sendbuf, void* recvbuf, int64_t count, CollDataType type, CollComm global_comm)
+{
   int total_size  = global_comm->global_comm_size;
   int global_rank = global_comm->global_rank;
 
@@ -42,6 +129,12 @@ int alltoallMPI(
   MPI_Aint lb, type_extent;
   MPI_Type_get_extent(mpi_type, &lb, &type_extent);
 
+  static const size_t bruck_threshold = extract_env(
+    "LEGATE_COLL_ALLTOALL_BRUCK_THRESHOLD", ALLTOALL_BRUCK_THRESHOLD, ALLTOALL_BRUCK_THRESHOLD);
+  if (total_size > 2 && static_cast<size_t>(type_extent * count) <= bruck_threshold) {
+    return alltoallBruck(sendbuf, recvbuf, count, mpi_type, type_extent, global_comm);
+  }
+
   int sendto_global_rank, recvfrom_global_rank, sendto_mpi_rank, recvfrom_mpi_rank;
   for (int i = 1; i < total_size + 1; i++) {
     sendto_global_rank   = (global_rank + i) % total_size;
@@ -72,18 +165,16 @@ int alltoallMPI(
       recvfrom_mpi_rank,
       recv_tag);
 #endif
-    CHECK_MPI(MPI_Sendrecv(src,
-                           count,
-                           mpi_type,
-                           sendto_mpi_rank,
-                           send_tag,
-                           dst,
-                           count,
-                           mpi_type,
-                           recvfrom_mpi_rank,
-                           recv_tag,
-                           global_comm->comm,
-                           &status));
+    sendrecvLarge(src,
+                  count,
+                  sendto_mpi_rank,
+                  send_tag,
+                  dst,
+                  count,
+                  recvfrom_mpi_rank,
+                  recv_tag,
+                  mpi_type,
+                  global_comm->comm);
   }
 
   return CollSuccess;
@@ -18,6 +18,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
 
 #include "coll.h"
 #include "legion.h"
@@ -30,11 +31,11 @@ using namespace Legion;
 extern Logger log_coll;
 
 int alltoallvLocal(const void* sendbuf,
-                   const int sendcounts[],
-                   const int sdispls[],
+                   const int64_t sendcounts[],
+                   const int64_t sdispls[],
                    void* recvbuf,
-                   const int recvcounts[],
-                   const int rdispls[],
+                   const int64_t recvcounts[],
+                   const int64_t rdispls[],
                    CollDataType type,
                    CollComm global_comm)
 {
@@ -45,51 +46,94 @@ int alltoallvLocal(const void* sendbuf,
 
   int type_extent = getDtypeSize(type);
 
-  global_comm->comm->displs[global_rank]  = sdispls;
-  global_comm->comm->buffers[global_rank] = sendbuf;
-  __sync_synchronize();
+  publishLocalBuffer(global_comm, sendbuf, sdispls);
 
   int recvfrom_global_rank;
   int recvfrom_seg_id  = global_rank;
   const void* src_base = nullptr;
-  const int* displs    = nullptr;
+  const int64_t* displs = nullptr;
   for (int i = 1; i < total_size + 1; i++) {
     recvfrom_global_rank = (global_rank + total_size - i) % total_size;
     // wait for other threads to update the buffer address
-    while (global_comm->comm->buffers[recvfrom_global_rank] == nullptr ||
-           global_comm->comm->displs[recvfrom_global_rank] == nullptr)
-      ;
-    src_base  = global_comm->comm->buffers[recvfrom_global_rank];
-    displs    = global_comm->comm->displs[recvfrom_global_rank];
+    waitLocal(global_comm, recvfrom_global_rank);
+    src_base  = global_comm->comm->slots[recvfrom_global_rank].buffer;
+    displs    = global_comm->comm->slots[recvfrom_global_rank].displs;
     char* src = static_cast<char*>(const_cast<void*>(src_base)) +
                 static_cast<ptrdiff_t>(displs[recvfrom_seg_id]) * type_extent;
     char* dst = static_cast<char*>(recvbuf) +
                 static_cast<ptrdiff_t>(rdispls[recvfrom_global_rank]) * type_extent;
 #ifdef DEBUG_LEGATE
     log_coll.debug(
-      "AlltoallvLocal i: %d === global_rank %d, dtype %d, copy rank %d (seg %d, sdispls %d, %p) to "
-      "rank %d (seg "
-      "%d, rdispls %d, %p)",
+      "AlltoallvLocal i: %d === global_rank %d, dtype %d, copy rank %d (seg %d, sdispls %lld, %p) "
+      "to rank %d (seg "
+      "%d, rdispls %lld, %p)",
       i,
       global_rank,
       type_extent,
       recvfrom_global_rank,
       recvfrom_seg_id,
-      sdispls[recvfrom_seg_id],
+      static_cast<long long>(displs[recvfrom_seg_id]),
       src,
       global_rank,
       recvfrom_global_rank,
-      rdispls[recvfrom_global_rank],
+      static_cast<long long>(rdispls[recvfrom_global_rank]),
       dst);
 #endif
     memcpy(dst, src, recvcounts[recvfrom_global_rank] * type_extent);
   }
 
+  // Keep the published buffer alive until every peer is done reading from it
   barrierLocal(global_comm);
 
-  __sync_synchronize();
+  return CollSuccess;
+}
+
+// What each rank publishes for an in-place exchange
+struct InplaceArgs {
+  char* buf;
+  const int64_t* counts;
+  const int64_t* displs;
+};
+
+int alltoallvInplaceLocal(void* buf,
+                          const int64_t counts[],
+                          const int64_t displs[],
+                          CollDataType type,
+                          CollComm global_comm)
+{
+  int total_size  = global_comm->global_comm_size;
+  int global_rank = global_comm->global_rank;
+
+  size_t type_extent = getDtypeSize(type);
+
+  InplaceArgs args{static_cast<char*>(buf), counts, displs};
+  publishLocalBuffer(global_comm, &args);
+
+  // The blocks of every pair of ranks are swapped directly between their buffers, by exactly one
+  // of the two. Each rank takes the pairs it forms with the ranks up to half the communicator
+  // ahead of it, which spreads the swaps evenly, and the swaps touch disjoint memory.
+  for (int i = 1; i <= total_size / 2; i++) {
+    int peer_global_rank = (global_rank + i) % total_size;
+    if (2 * i == total_size && peer_global_rank < global_rank) { continue; }
+    waitLocal(global_comm, peer_global_rank);
+    const InplaceArgs* peer =
+      static_cast<const InplaceArgs*>(global_comm->comm->slots[peer_global_rank].buffer);
+    assert(counts[peer_global_rank] == peer->counts[global_rank]);
+    char* block = args.buf + static_cast<ptrdiff_t>(displs[peer_global_rank]) * type_extent;
+    char* peer_block =
+      peer->buf + static_cast<ptrdiff_t>(peer->displs[global_rank]) * type_extent;
+#ifdef DEBUG_LEGATE
+    log_coll.debug("AlltoallvInplaceLocal i: %d === global_rank %d, swap %p with rank %d (%p)",
+                   i,
+                   global_rank,
+                   block,
+                   peer_global_rank,
+                   peer_block);
+#endif
+    std::swap_ranges(block, block + counts[peer_global_rank] * type_extent, peer_block);
+  }
 
-  resetLocalBuffer(global_comm);
+  // Peers may still be swapping blocks of our buffer
   barrierLocal(global_comm);
 
   return CollSuccess;
@@ -19,6 +19,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <algorithm>
+#include <vector>
 
 #include "coll.h"
 #include "legion.h"
@@ -30,74 +31,292 @@ namespace coll {
 using namespace Legion;
 extern Logger log_coll;
 
+// What each rank publishes so that the other ranks in its process can read its buffers
+struct AlltoallvArgs {
+  const void* sendbuf;
+  const int64_t* sendcounts;
+  const int64_t* sdispls;
+  void* recvbuf;
+  const int64_t* recvcounts;
+  const int64_t* rdispls;
+};
+
+// The data exchanged between this process and one peer process, aggregated over all the
+// ranks living in either of them
+struct ProcessExchange {
+  int mpi_rank;
+  std::vector<int> global_ranks;
+  std::vector<char> sendbuf;
+  std::vector<char> recvbuf;
+  const char* send_ptr;
+  char* recv_ptr;
+  int64_t send_count;
+  int64_t recv_count;
+};
+
+// What each rank publishes for an in-place exchange
+struct InplaceArgs {
+  char* buf;
+  const int64_t* counts;
+  const int64_t* displs;
+};
+
+// In-place exchanges with remote ranks go through MPI_Sendrecv_replace in pieces of at most this
+// many bytes, which bounds the scratch space MPI needs
+static constexpr size_t INPLACE_CHUNK_SIZE = 4 << 20;
+
 int alltoallvMPI(const void* sendbuf,
-                 const int sendcounts[],
-                 const int sdispls[],
+                 const int64_t sendcounts[],
+                 const int64_t sdispls[],
                  void* recvbuf,
-                 const int recvcounts[],
-                 const int rdispls[],
+                 const int64_t recvcounts[],
+                 const int64_t rdispls[],
                  CollDataType type,
                  CollComm global_comm)
 {
-  MPI_Status status;
-
-  int total_size  = global_comm->global_comm_size;
-  int global_rank = global_comm->global_rank;
+  int total_size         = global_comm->global_comm_size;
+  int global_rank        = global_comm->global_rank;
+  int local_size         = global_comm->local_comm_size;
+  int local_rank         = global_comm->local_rank;
+  const int* local_ranks = global_comm->local_ranks;
 
   MPI_Datatype mpi_type = dtypeToMPIDtype(type);
 
   MPI_Aint lb, type_extent;
   MPI_Type_get_extent(mpi_type, &lb, &type_extent);
 
-  int sendto_global_rank, recvfrom_global_rank, sendto_mpi_rank, recvfrom_mpi_rank;
-  for (int i = 1; i < total_size + 1; i++) {
-    sendto_global_rank   = (global_rank + i) % total_size;
-    recvfrom_global_rank = (global_rank + total_size - i) % total_size;
-    char* src            = static_cast<char*>(const_cast<void*>(sendbuf)) +
-                static_cast<ptrdiff_t>(sdispls[sendto_global_rank]) * type_extent;
-    char* dst = static_cast<char*>(recvbuf) +
+  AlltoallvArgs args{sendbuf, sendcounts, sdispls, recvbuf, recvcounts, rdispls};
+  publishLocalBuffer(global_comm, &args);
+
+  // Blocks exchanged with ranks in the same process are copied directly
+  std::vector<const AlltoallvArgs*> local_args(local_size);
+  for (int i = 1; i < local_size + 1; i++) {
+    int recvfrom_local_rank = (local_rank + local_size - i) % local_size;
+    waitLocal(global_comm, recvfrom_local_rank);
+    const AlltoallvArgs* peer = static_cast<const AlltoallvArgs*>(
+      global_comm->local_comm->slots[recvfrom_local_rank].buffer);
+    local_args[recvfrom_local_rank] = peer;
+
+    int recvfrom_global_rank = local_ranks[recvfrom_local_rank];
+    const char* src          = static_cast<const char*>(peer->sendbuf) +
+                      static_cast<ptrdiff_t>(peer->sdispls[global_rank]) * type_extent;
+    char* dst                = static_cast<char*>(recvbuf) +
                 static_cast<ptrdiff_t>(rdispls[recvfrom_global_rank]) * type_extent;
-    int scount        = sendcounts[sendto_global_rank];
-    int rcount        = recvcounts[recvfrom_global_rank];
-    sendto_mpi_rank   = global_comm->mapping_table.mpi_rank[sendto_global_rank];
-    recvfrom_mpi_rank = global_comm->mapping_table.mpi_rank[recvfrom_global_rank];
-    assert(sendto_global_rank == global_comm->mapping_table.global_rank[sendto_global_rank]);
-    assert(recvfrom_global_rank == global_comm->mapping_table.global_rank[recvfrom_global_rank]);
-    // tag: seg idx + rank_idx + tag
-    int send_tag = generateAlltoallvTag(sendto_global_rank, global_rank, global_comm);
-    int recv_tag = generateAlltoallvTag(global_rank, recvfrom_global_rank, global_comm);
 #ifdef DEBUG_LEGATE
     log_coll.debug(
-      "AlltoallvMPI i: %d === global_rank %d, mpi rank %d, send to %d (%d), send_tag %d, "
-      "recv from %d (%d), "
-      "recv_tag %d",
+      "AlltoallvMPI local i: %d === global_rank %d, mpi rank %d, copy from %d (%p) to %p",
       i,
       global_rank,
       global_comm->mpi_rank,
-      sendto_global_rank,
-      sendto_mpi_rank,
-      send_tag,
       recvfrom_global_rank,
-      recvfrom_mpi_rank,
+      src,
+      dst);
+#endif
+    memcpy(dst, src, recvcounts[recvfrom_global_rank] * type_extent);
+  }
+
+  // Traffic to each peer process is aggregated into a single message per direction. The peer
+  // processes are distributed round-robin over the local ranks, which pack and unpack the
+  // messages on behalf of all ranks of this process.
+  std::vector<std::vector<int>> ranks_per_process(global_comm->mpi_comm_size);
+  for (int i = 0; i < total_size; i++) {
+    assert(i == global_comm->mapping_table.global_rank[i]);
+    ranks_per_process[global_comm->mapping_table.mpi_rank[i]].push_back(i);
+  }
+
+  std::vector<ProcessExchange> exchanges;
+  for (int i = 1; i < global_comm->mpi_comm_size; i++) {
+    int peer_mpi_rank = (global_comm->mpi_rank + i) % global_comm->mpi_comm_size;
+    if (peer_mpi_rank % local_size != local_rank) { continue; }
+    if (ranks_per_process[peer_mpi_rank].empty()) { continue; }
+    exchanges.emplace_back();
+    ProcessExchange& exchange = exchanges.back();
+    exchange.mpi_rank         = peer_mpi_rank;
+    exchange.global_ranks     = ranks_per_process[peer_mpi_rank];
+  }
+
+  std::vector<MPI_Request> requests;
+  requests.reserve(2 * exchanges.size());
+  for (ProcessExchange& exchange : exchanges) {
+    // Blocks are laid out by destination rank first and source rank second in both directions
+    exchange.send_count = 0;
+    for (int dst_rank : exchange.global_ranks) {
+      for (int l = 0; l < local_size; l++) {
+        exchange.send_count += local_args[l]->sendcounts[dst_rank];
+      }
+    }
+    exchange.recv_count = 0;
+    for (int l = 0; l < local_size; l++) {
+      for (int src_rank : exchange.global_ranks) {
+        exchange.recv_count += local_args[l]->recvcounts[src_rank];
+      }
+    }
+    // A single block on each side needs no staging
+    bool single_block = local_size == 1 && exchange.global_ranks.size() == 1;
+    if (single_block) {
+      int peer_rank     = exchange.global_ranks[0];
+      exchange.send_ptr = static_cast<const char*>(sendbuf) +
+                          static_cast<ptrdiff_t>(sdispls[peer_rank]) * type_extent;
+      exchange.recv_ptr =
+        static_cast<char*>(recvbuf) + static_cast<ptrdiff_t>(rdispls[peer_rank]) * type_extent;
+    } else {
+      exchange.sendbuf.resize(exchange.send_count * type_extent);
+      exchange.recvbuf.resize(exchange.recv_count * type_extent);
+      char* dst = exchange.sendbuf.data();
+      for (int dst_rank : exchange.global_ranks) {
+        for (int l = 0; l < local_size; l++) {
+          const AlltoallvArgs* src_args = local_args[l];
+          size_t size                   = src_args->sendcounts[dst_rank] * type_extent;
+          memcpy(dst,
+                 static_cast<const char*>(src_args->sendbuf) +
+                   static_cast<ptrdiff_t>(src_args->sdispls[dst_rank]) * type_extent,
+                 size);
+          dst += size;
+        }
+      }
+      exchange.send_ptr = exchange.sendbuf.data();
+      exchange.recv_ptr = exchange.recvbuf.data();
+    }
+
+    int peer_lead_rank = exchange.global_ranks[0];
+    int send_tag       = generateAlltoallvTag(peer_lead_rank, local_ranks[0], global_comm);
+    int recv_tag       = generateAlltoallvTag(local_ranks[0], peer_lead_rank, global_comm);
+#ifdef DEBUG_LEGATE
+    log_coll.debug(
+      "AlltoallvMPI remote === global_rank %d, mpi rank %d, exchange with mpi rank %d, send %lld "
+      "send_tag %d, recv %lld, recv_tag %d",
+      global_rank,
+      global_comm->mpi_rank,
+      exchange.mpi_rank,
+      static_cast<long long>(exchange.send_count),
+      send_tag,
+      static_cast<long long>(exchange.recv_count),
       recv_tag);
 #endif
-    CHECK_MPI(MPI_Sendrecv(src,
-                           scount,
-                           mpi_type,
-                           sendto_mpi_rank,
-                           send_tag,
-                           dst,
-                           rcount,
-                           mpi_type,
-                           recvfrom_mpi_rank,
-                           recv_tag,
-                           global_comm->comm,
-                           &status));
+    if (exchange.recv_count > 0) {
+      irecvLarge(exchange.recv_ptr,
+                 exchange.recv_count,
+                 mpi_type,
+                 exchange.mpi_rank,
+                 recv_tag,
+                 global_comm->comm,
+                 requests);
+    }
+    if (exchange.send_count > 0) {
+      isendLarge(exchange.send_ptr,
+                 exchange.send_count,
+                 mpi_type,
+                 exchange.mpi_rank,
+                 send_tag,
+                 global_comm->comm,
+                 requests);
+    }
+  }
+  CHECK_MPI_WAIT(MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE));
+
+  for (ProcessExchange& exchange : exchanges) {
+    if (!exchange.recvbuf.empty()) {
+      const char* src = exchange.recvbuf.data();
+      for (int l = 0; l < local_size; l++) {
+        const AlltoallvArgs* dst_args = local_args[l];
+        for (int src_rank : exchange.global_ranks) {
+          size_t size = dst_args->recvcounts[src_rank] * type_extent;
+          memcpy(static_cast<char*>(dst_args->recvbuf) +
+                   static_cast<ptrdiff_t>(dst_args->rdispls[src_rank]) * type_extent,
+                 src,
+                 size);
+          src += size;
+        }
+      }
+    }
+  }
+
+  // Other local ranks may still be reading our sendbuf or writing into our recvbuf
+  barrierLocal(global_comm);
+
+  return CollSuccess;
+}
+
+int alltoallvInplaceMPI(void* buf,
+                        const int64_t counts[],
+                        const int64_t displs[],
+                        CollDataType type,
+                        CollComm global_comm)
+{
+  int total_size         = global_comm->global_comm_size;
+  int global_rank        = global_comm->global_rank;
+  int local_size         = global_comm->local_comm_size;
+  int local_rank         = global_comm->local_rank;
+  const int* local_ranks = global_comm->local_ranks;
+
+  MPI_Datatype mpi_type = dtypeToMPIDtype(type);
+
+  MPI_Aint lb, type_extent;
+  MPI_Type_get_extent(mpi_type, &lb, &type_extent);
+
+  InplaceArgs args{static_cast<char*>(buf), counts, displs};
+  publishLocalBuffer(global_comm, &args);
+
+  // Blocks of ranks in the same process are swapped directly between their buffers, each pair by
+  // exactly one of the two ranks
+  for (int i = 1; i <= local_size / 2; i++) {
+    int peer_local_rank = (local_rank + i) % local_size;
+    if (2 * i == local_size && peer_local_rank < local_rank) { continue; }
+    waitLocal(global_comm, peer_local_rank);
+    const InplaceArgs* peer =
+      static_cast<const InplaceArgs*>(global_comm->local_comm->slots[peer_local_rank].buffer);
+    int peer_global_rank = local_ranks[peer_local_rank];
+    assert(counts[peer_global_rank] == peer->counts[global_rank]);
+    char* block = args.buf + static_cast<ptrdiff_t>(displs[peer_global_rank]) * type_extent;
+    char* peer_block =
+      peer->buf + static_cast<ptrdiff_t>(peer->displs[global_rank]) * type_extent;
+    std::swap_ranges(block, block + counts[peer_global_rank] * type_extent, peer_block);
+  }
+
+  // Blocks of remote ranks are exchanged pairwise. In round k, rank r is paired with rank
+  // k - r, so every pair meets in exactly one round and ranks going through the rounds in order
+  // never wait on each other in a cycle.
+  int64_t chunk_count = std::max<int64_t>(INPLACE_CHUNK_SIZE / type_extent, 1);
+  for (int k = 0; k < total_size; k++) {
+    int peer_global_rank = (k + total_size - global_rank) % total_size;
+    int peer_mpi_rank    = global_comm->mapping_table.mpi_rank[peer_global_rank];
+    if (peer_mpi_rank == global_comm->mpi_rank) { continue; }
+    int send_tag = generateAlltoallvTag(peer_global_rank, global_rank, global_comm);
+    int recv_tag = generateAlltoallvTag(global_rank, peer_global_rank, global_comm);
+#ifdef DEBUG_LEGATE
+    log_coll.debug(
+      "AlltoallvInplaceMPI k: %d === global_rank %d, mpi rank %d, exchange with %d (%d), "
+      "send_tag %d, recv_tag %d, count %lld",
+      k,
+      global_rank,
+      global_comm->mpi_rank,
+      peer_global_rank,
+      peer_mpi_rank,
+      send_tag,
+      recv_tag,
+      static_cast<long long>(counts[peer_global_rank]));
+#endif
+    char* block = args.buf + static_cast<ptrdiff_t>(displs[peer_global_rank]) * type_extent;
+    for (int64_t offset = 0; offset < counts[peer_global_rank]; offset += chunk_count) {
+      int count = static_cast<int>(std::min(chunk_count, counts[peer_global_rank] - offset));
+      CHECK_MPI_WAIT(MPI_Sendrecv_replace(block + offset * type_extent,
+                                          count,
+                                          mpi_type,
+                                          peer_mpi_rank,
+                                          send_tag,
+                                          peer_mpi_rank,
+                                          recv_tag,
+                                          global_comm->comm,
+                                          MPI_STATUS_IGNORE));
+    }
   }
 
+  // Other local ranks may still be swapping blocks of our buffer
+  barrierLocal(global_comm);
+
   return CollSuccess;
 }
 
 }  // namespace coll
 }  // namespace comm
-}  // namespace legate
\ No newline at end of file
+}  // namespace legate
@@ -0,0 +1,65 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "coll.h"
+#include "legion.h"
+
+namespace legate {
+namespace comm {
+namespace coll {
+
+using namespace Legion;
+extern Logger log_coll;
+
+int bcastLocal(void* buf, int64_t count, CollDataType type, int root, CollComm global_comm)
+{
+  int global_rank = global_comm->global_rank;
+
+  int type_extent = getDtypeSize(type);
+
+  // Only the root's buffer matters, the others publish theirs to keep the sequence in step
+  publishLocalBuffer(global_comm, buf);
+
+  if (global_rank != root) {
+    // wait for the root to update the buffer address
+    waitLocal(global_comm, root);
+    const void* src = global_comm->comm->slots[root].buffer;
+#ifdef DEBUG_LEGATE
+    log_coll.debug("BcastLocal: global_rank %d, dtype %d, copy rank %d (%p) to rank %d (%p)",
+                   global_rank,
+                   type_extent,
+                   root,
+                   src,
+                   global_rank,
+                   buf);
+#endif
+    memcpy(buf, src, count * type_extent);
+  }
+
+  // Keep the published buffer alive until every peer is done reading from it
+  barrierLocal(global_comm);
+
+  return CollSuccess;
+}
+
+}  // namespace coll
+}  // namespace comm
+}  // namespace legate
@@ -18,6 +18,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
 
 #include "coll.h"
 #include "legion.h"
@@ -29,54 +30,150 @@ namespace coll {
 using namespace Legion;
 extern Logger log_coll;
 
-int bcastMPI(void* buf, int count, CollDataType type, int root, CollComm global_comm)
-{
-  int tag;
-  MPI_Status status;
-
-  int total_size  = global_comm->global_comm_size;
-  int global_rank = global_comm->global_rank;
-
-  int root_mpi_rank = global_comm->mapping_table.mpi_rank[root];
-  assert(root == global_comm->mapping_table.global_rank[root]);
+// Payloads from this size on are scattered and then allgathered, which keeps every link busy
+// instead of pushing the whole payload down each level of the tree
+static constexpr size_t BCAST_SCATTER_THRESHOLD = 512 << 10;
 
-  MPI_Datatype mpi_type = dtypeToMPIDtype(type);
+// Binomial tree on the rank relative to the root: a rank receives the payload from the partner
+// that differs in its lowest set bit, then forwards it to the partners below that bit
+static void bcastBinomial(void* buf,
+                          int64_t count,
+                          MPI_Datatype mpi_type,
+                          int root,
+                          CollComm global_comm)
+{
+  int total_size    = global_comm->global_comm_size;
+  int global_rank   = global_comm->global_rank;
+  int relative_rank = (global_rank + total_size - root) % total_size;
 
-  // non-root
-  if (global_rank != root) {
-    tag = generateBcastTag(global_rank, global_comm);
+  int mask = 1;
+  for (; mask < total_size; mask <<= 1) {
+    if (relative_rank & mask) {
+      int recvfrom_global_rank = (relative_rank - mask + root) % total_size;
+      int recvfrom_mpi_rank    = global_comm->mapping_table.mpi_rank[recvfrom_global_rank];
+      int tag = generateBcastTag(global_rank, recvfrom_global_rank, global_comm);
 #ifdef DEBUG_LEGATE
-    log_coll.debug("BcastMPI: non-root recv global_rank %d, mpi rank %d, send to %d (%d), tag %d",
-                   global_rank,
-                   global_comm->mpi_rank,
-                   root,
-                   root_mpi_rank,
-                   tag);
+      log_coll.debug("BcastMPI: global_rank %d, mpi rank %d, recv from %d (%d), tag %d",
+                     global_rank,
+                     global_comm->mpi_rank,
+                     recvfrom_global_rank,
+                     recvfrom_mpi_rank,
+                     tag);
 #endif
-    CHECK_MPI(MPI_Recv(buf, count, mpi_type, root_mpi_rank, tag, global_comm->comm, &status));
-    return CollSuccess;
+      recvLarge(buf, count, mpi_type, recvfrom_mpi_rank, tag, global_comm->comm);
+      break;
+    }
   }
-
-  // root
-  int sendto_mpi_rank;
-  for (int i = 0; i < total_size; i++) {
-    sendto_mpi_rank = global_comm->mapping_table.mpi_rank[i];
-    assert(i == global_comm->mapping_table.global_rank[i]);
-    tag = generateBcastTag(i, global_comm);
+  for (mask >>= 1; mask > 0; mask >>= 1) {
+    if (relative_rank + mask >= total_size) { continue; }
+    int sendto_global_rank = (relative_rank + mask + root) % total_size;
+    int sendto_mpi_rank    = global_comm->mapping_table.mpi_rank[sendto_global_rank];
+    int tag                = generateBcastTag(sendto_global_rank, global_rank, global_comm);
 #ifdef DEBUG_LEGATE
-    log_coll.debug("BcastMPI: root i %d === global_rank %d, mpi rank %d, send to %d (%d), tag %d",
-                   i,
+    log_coll.debug("BcastMPI: global_rank %d, mpi rank %d, send to %d (%d), tag %d",
                    global_rank,
                    global_comm->mpi_rank,
-                   i,
+                   sendto_global_rank,
                    sendto_mpi_rank,
                    tag);
 #endif
-    if (global_rank != i) {
-      CHECK_MPI(MPI_Send(buf, count, mpi_type, sendto_mpi_rank, tag, global_comm->comm));
+    sendLarge(buf, count, mpi_type, sendto_mpi_rank, tag, global_comm->comm);
+  }
+}
+
+// Van de Geijn broadcast: the payload is cut into one chunk per rank, the chunks are scattered
+// down the binomial tree, and a ring allgather then completes the payload on every rank
+static void bcastScatterAllgather(void* buf,
+                                  int64_t count,
+                                  MPI_Datatype mpi_type,
+                                  MPI_Aint type_extent,
+                                  int root,
+                                  CollComm global_comm)
+{
+  int total_size    = global_comm->global_comm_size;
+  int global_rank   = global_comm->global_rank;
+  int relative_rank = (global_rank + total_size - root) % total_size;
+
+  // Chunk i belongs to relative rank i; the trailing chunks may be short or empty
+  int64_t chunk_count = (count + total_size - 1) / total_size;
+  auto chunk_begin    = [&](int64_t chunk) { return std::min(chunk * chunk_count, count); };
+  auto chunk_ptr      = [&](int64_t chunk) {
+    return static_cast<char*>(buf) + static_cast<ptrdiff_t>(chunk_begin(chunk)) * type_extent;
+  };
+
+  // Scatter: every rank receives the chunks of its whole subtree from its parent
+  int mask = 1;
+  for (; mask < total_size; mask <<= 1) {
+    if (relative_rank & mask) {
+      int recvfrom_global_rank = (relative_rank - mask + root) % total_size;
+      int recvfrom_mpi_rank    = global_comm->mapping_table.mpi_rank[recvfrom_global_rank];
+      int tag = generateBcastTag(global_rank, recvfrom_global_rank, global_comm);
+      int64_t recv_count =
+        chunk_begin(std::min(relative_rank + mask, total_size)) - chunk_begin(relative_rank);
+      if (recv_count > 0) {
+        recvLarge(chunk_ptr(relative_rank),
+                  recv_count,
+                  mpi_type,
+                  recvfrom_mpi_rank,
+                  tag,
+                  global_comm->comm);
+      }
+      break;
+    }
+  }
+  for (mask >>= 1; mask > 0; mask >>= 1) {
+    int child = relative_rank + mask;
+    if (child >= total_size) { continue; }
+    int sendto_global_rank = (child + root) % total_size;
+    int sendto_mpi_rank    = global_comm->mapping_table.mpi_rank[sendto_global_rank];
+    int tag                = generateBcastTag(sendto_global_rank, global_rank, global_comm);
+    int64_t send_count = chunk_begin(std::min(child + mask, total_size)) - chunk_begin(child);
+    if (send_count > 0) {
+      sendLarge(chunk_ptr(child), send_count, mpi_type, sendto_mpi_rank, tag, global_comm->comm);
     }
   }
 
+  // Ring allgather over relative ranks: in step i, forward the chunk received in step i - 1
+  int right_global_rank = (relative_rank + 1 + root) % total_size;
+  int left_global_rank  = (relative_rank + total_size - 1 + root) % total_size;
+  int right_mpi_rank    = global_comm->mapping_table.mpi_rank[right_global_rank];
+  int left_mpi_rank     = global_comm->mapping_table.mpi_rank[left_global_rank];
+  int send_tag          = generateBcastRingTag(right_global_rank, global_rank, global_comm);
+  int recv_tag          = generateBcastRingTag(global_rank, left_global_rank, global_comm);
+  for (int i = 0; i < total_size - 1; i++) {
+    int send_chunk = (relative_rank + total_size - i) % total_size;
+    int recv_chunk = (relative_rank + total_size - i - 1) % total_size;
+    sendrecvLarge(chunk_ptr(send_chunk),
+                  chunk_begin(send_chunk + 1) - chunk_begin(send_chunk),
+                  right_mpi_rank,
+                  send_tag,
+                  chunk_ptr(recv_chunk),
+                  chunk_begin(recv_chunk + 1) - chunk_begin(recv_chunk),
+                  left_mpi_rank,
+                  recv_tag,
+                  mpi_type,
+                  global_comm->comm);
+  }
+}
+
+int bcastMPI(void* buf, int64_t count, CollDataType type, int root, CollComm global_comm)
+{
+  int total_size = global_comm->global_comm_size;
+  assert(root == global_comm->mapping_table.global_rank[root]);
+
+  if (total_size == 1) { return CollSuccess; }
+
+  MPI_Datatype mpi_type = dtypeToMPIDtype(type);
+
+  MPI_Aint lb, type_extent;
+  MPI_Type_get_extent(mpi_type, &lb, &type_extent);
+
+  if (total_size > 2 && static_cast<size_t>(count * type_extent) >= BCAST_SCATTER_THRESHOLD) {
+    bcastScatterAllgather(buf, count, mpi_type, type_extent, root, global_comm);
+  } else {
+    bcastBinomial(buf, count, mpi_type, root, global_comm);
+  }
+
   return CollSuccess;
 }
 
@@ -0,0 +1,462 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Micro-benchmark of the CPU collectives in coll.h, run outside of any Legate task.
+//
+// Each process spawns one thread per local rank. With the network backend the benchmark is
+// launched under mpirun, and every process contributes the same number of ranks, which are
+// numbered process by process. One CSV row is printed per (collective, type, ranks, bytes)
+// configuration; latencies are the slowest rank of each iteration, in microseconds, and the
+// bandwidth, in gigabytes per second, is the number of bytes a rank receives divided by the
+// median latency.
+//
+// The alltoall_legacy collective is a copy of the thread-local alltoall from before the per-rank
+// mailboxes, where ranks spin on the buffer pointers of their peers and every call ends with two
+// barriers. It only runs within a single process, and measures the mailboxes against the old
+// design, e.g. with:
+//
+//   coll_bench -c alltoall,alltoall_legacy -d int32 -t 2,4,8 -m 4 -M 4 -i 200
+//
+// Usage: coll_bench [-c alltoall,alltoallv,allgather,bcast,gather,alltoall_legacy]
+//                   [-d int8,int32,...] [-t 1,2,4] [-m min_bytes] [-M max_bytes] [-i iters]
+//                   [-w warmup]
+
+#include <assert.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/comm/coll.h"
+
+using namespace legate::comm::coll;
+
+namespace {
+
+enum class Collective : int {
+  Alltoall  = 0,
+  Alltoallv = 1,
+  Allgather = 2,
+  Bcast     = 3,
+  Gather    = 4,
+  // Not run by default
+  AlltoallLegacy = 5,
+};
+
+struct CollectiveInfo {
+  const char* name;
+  Collective kind;
+};
+
+const CollectiveInfo COLLECTIVES[] = {
+  {"alltoall", Collective::Alltoall},
+  {"alltoallv", Collective::Alltoallv},
+  {"allgather", Collective::Allgather},
+  {"bcast", Collective::Bcast},
+  {"gather", Collective::Gather},
+  {"alltoall_legacy", Collective::AlltoallLegacy},
+};
+
+struct DataTypeInfo {
+  const char* name;
+  CollDataType type;
+  size_t size;
+};
+
+const DataTypeInfo DATA_TYPES[] = {
+  {"bool", CollDataType::CollBool, 1},
+  {"int8", CollDataType::CollInt8, 1},
+  {"uint8", CollDataType::CollUint8, 1},
+  {"int16", CollDataType::CollInt16, 2},
+  {"uint16", CollDataType::CollUint16, 2},
+  {"int32", CollDataType::CollInt, 4},
+  {"uint32", CollDataType::CollUint32, 4},
+  {"int64", CollDataType::CollInt64, 8},
+  {"uint64", CollDataType::CollUint64, 8},
+  {"half", CollDataType::CollHalf, 2},
+  {"float", CollDataType::CollFloat, 4},
+  {"double", CollDataType::CollDouble, 8},
+  {"complex64", CollDataType::CollComplex64, 8},
+  {"complex128", CollDataType::CollComplex128, 16},
+};
+
+struct Options {
+  std::vector<CollectiveInfo> collectives;
+  std::vector<DataTypeInfo> types;
+  std::vector<int> threads;
+  size_t min_bytes = 8;
+  size_t max_bytes = 1 << 22;
+  int iters        = 100;
+  int warmup       = 10;
+};
+
+struct Config {
+  CollectiveInfo collective;
+  DataTypeInfo type;
+  int64_t count;
+};
+
+// Shared state of the legacy alltoall, one per process
+struct LegacyComm {
+  pthread_barrier_t barrier;
+  std::unique_ptr<std::atomic<const void*>[]> buffers;
+};
+
+// State shared by the threads of one process for a given thread count
+struct BenchState {
+  const Options* options;
+  const std::vector<Config>* configs;
+  int nb_threads;
+  int mpi_rank;
+  int mpi_comm_size;
+  int unique_id;
+  LegacyComm legacy;
+  // Per-iteration latencies of every local rank, indexed by [config][thread][iteration]
+  std::vector<std::vector<std::vector<double>>> latencies;
+};
+
+std::vector<std::string> split(const char* arg)
+{
+  std::vector<std::string> tokens;
+  std::string token;
+  for (const char* p = arg;; p++) {
+    if (*p == ',' || *p == '\0') {
+      if (!token.empty()) { tokens.push_back(token); }
+      token.clear();
+      if (*p == '\0') { break; }
+    } else {
+      token.push_back(*p);
+    }
+  }
+  return tokens;
+}
+
+template <typename T, size_t N>
+T lookup(const T (&table)[N], const std::string& name, const char* what)
+{
+  for (const T& entry : table) {
+    if (name == entry.name) { return entry; }
+  }
+  fprintf(stderr, "Unknown %s: %s\n", what, name.c_str());
+  exit(1);
+}
+
+void usage(const char* prog)
+{
+  fprintf(stderr,
+          "Usage: %s [-c alltoall,alltoallv,allgather,bcast,gather,alltoall_legacy] "
+          "[-d bool,int8,uint8,int16,uint16,int32,uint32,int64,uint64,half,float,double,"
+          "complex64,complex128] [-t threads,...] "
+          "[-m min_bytes] [-M max_bytes] [-i iters] [-w warmup]\n",
+          prog);
+  exit(1);
+}
+
+Options parse_options(int argc, char* argv[])
+{
+  Options options;
+  int opt;
+  while ((opt = getopt(argc, argv, "c:d:t:m:M:i:w:h")) != -1) {
+    switch (opt) {
+      case 'c': {
+        for (auto& name : split(optarg))
+          options.collectives.push_back(lookup(COLLECTIVES, name, "collective"));
+        break;
+      }
+      case 'd': {
+        for (auto& name : split(optarg))
+          options.types.push_back(lookup(DATA_TYPES, name, "data type"));
+        break;
+      }
+      case 't': {
+        for (auto& value : split(optarg)) options.threads.push_back(atoi(value.c_str()));
+        break;
+      }
+      case 'm': options.min_bytes = strtoull(optarg, nullptr, 10); break;
+      case 'M': options.max_bytes = strtoull(optarg, nullptr, 10); break;
+      case 'i': options.iters = atoi(optarg); break;
+      case 'w': options.warmup = atoi(optarg); break;
+      default: usage(argv[0]);
+    }
+  }
+  if (options.collectives.empty())
+    for (auto& collective : COLLECTIVES)
+      if (collective.kind != Collective::AlltoallLegacy)
+        options.collectives.push_back(collective);
+  if (options.types.empty()) options.types.push_back(DATA_TYPES[0]);
+  if (options.threads.empty()) options.threads = {1, 2, 4};
+  if (options.min_bytes == 0 || options.min_bytes > options.max_bytes || options.iters <= 0 ||
+      options.warmup < 0)
+    usage(argv[0]);
+  for (int nb_threads : options.threads)
+    if (nb_threads <= 0) usage(argv[0]);
+  return options;
+}
+
+std::vector<Config> make_configs(const Options& options)
+{
+  std::vector<Config> configs;
+  for (auto& collective : options.collectives)
+    for (auto& type : options.types)
+      for (size_t bytes = options.min_bytes; bytes <= options.max_bytes; bytes *= 2) {
+        if (bytes < type.size) continue;
+        configs.push_back(Config{collective, type, static_cast<int64_t>(bytes / type.size)});
+      }
+  return configs;
+}
+
+// Number of bytes a rank, or the root for gather, receives in one call
+double received_bytes(const Config& config, int total_size)
+{
+  double bytes = static_cast<double>(config.count) * config.type.size;
+  switch (config.collective.kind) {
+    case Collective::Alltoall:
+    case Collective::Alltoallv:
+    case Collective::AlltoallLegacy:
+    case Collective::Allgather:
+    case Collective::Gather: return bytes * (total_size - 1);
+    case Collective::Bcast: return bytes;
+  }
+  return bytes;
+}
+
+// The thread-local alltoall before the per-rank mailboxes. Each rank publishes its send buffer
+// and spins until the buffers of its peers are published; once every rank is done copying, the
+// pointers are cleared, and a second barrier keeps the next call from publishing too early.
+int alltoall_legacy(
+  const char* sendbuf, char* recvbuf, size_t block_size, LegacyComm* legacy, CollComm comm)
+{
+  int total_size  = comm->global_comm_size;
+  int global_rank = comm->global_rank;
+
+  legacy->buffers[global_rank].store(sendbuf, std::memory_order_release);
+  for (int i = 1; i < total_size + 1; i++) {
+    int recvfrom_global_rank = (global_rank + total_size - i) % total_size;
+    const void* src_base;
+    while ((src_base = legacy->buffers[recvfrom_global_rank].load(std::memory_order_acquire)) ==
+           nullptr)
+      ;
+    memcpy(recvbuf + recvfrom_global_rank * block_size,
+           static_cast<const char*>(src_base) + global_rank * block_size,
+           block_size);
+  }
+
+  pthread_barrier_wait(&legacy->barrier);
+  legacy->buffers[global_rank].store(nullptr, std::memory_order_relaxed);
+  pthread_barrier_wait(&legacy->barrier);
+  return CollSuccess;
+}
+
+int run_collective(const Config& config,
+                   const char* sendbuf,
+                   char* recvbuf,
+                   const std::vector<int>& counts,
+                   const std::vector<int>& displs,
+                   LegacyComm* legacy,
+                   CollComm comm)
+{
+  int count         = static_cast<int>(config.count);
+  CollDataType type = config.type.type;
+  switch (config.collective.kind) {
+    case Collective::Alltoall: return collAlltoall(sendbuf, recvbuf, count, type, comm);
+    case Collective::Alltoallv:
+      return collAlltoallv(sendbuf,
+                           counts.data(),
+                           displs.data(),
+                           recvbuf,
+                           counts.data(),
+                           displs.data(),
+                           type,
+                           comm);
+    case Collective::Allgather: return collAllgather(sendbuf, recvbuf, count, type, comm);
+    case Collective::Bcast: return collBcast(recvbuf, count, type, 0, comm);
+    case Collective::Gather: return collGather(sendbuf, recvbuf, count, type, 0, comm);
+    case Collective::AlltoallLegacy:
+      return alltoall_legacy(sendbuf, recvbuf, count * config.type.size, legacy, comm);
+  }
+  return CollError;
+}
+
+struct WorkerArgs {
+  BenchState* state;
+  int thread_id;
+};
+
+void* worker(void* arg)
+{
+  WorkerArgs* args       = static_cast<WorkerArgs*>(arg);
+  BenchState* state      = args->state;
+  const Options& options = *state->options;
+  int nb_threads         = state->nb_threads;
+  int total_size         = nb_threads * state->mpi_comm_size;
+  int global_rank        = state->mpi_rank * nb_threads + args->thread_id;
+
+  Coll_Comm comm;
+#ifdef LEGATE_USE_NETWORK
+  std::vector<int> mapping_table(total_size);
+  for (int i = 0; i < total_size; i++) mapping_table[i] = i / nb_threads;
+  collCommCreate(&comm, total_size, global_rank, state->unique_id, mapping_table.data());
+#else
+  collCommCreate(&comm, total_size, global_rank, state->unique_id, nullptr);
+#endif
+
+  for (size_t idx = 0; idx < state->configs->size(); idx++) {
+    const Config& config = (*state->configs)[idx];
+    size_t block_size    = config.count * config.type.size;
+    std::vector<char> sendbuf(block_size * total_size, static_cast<char>(global_rank));
+    std::vector<char> recvbuf(block_size * total_size);
+    std::vector<int> counts(total_size, static_cast<int>(config.count));
+    std::vector<int> displs(total_size);
+    for (int i = 0; i < total_size; i++) displs[i] = i * static_cast<int>(config.count);
+
+    std::vector<double>& latencies = state->latencies[idx][args->thread_id];
+    latencies.resize(options.iters);
+    for (int iter = -options.warmup; iter < options.iters; iter++) {
+      auto start = std::chrono::steady_clock::now();
+      if (run_collective(
+            config, sendbuf.data(), recvbuf.data(), counts, displs, &state->legacy, &comm) !=
+          CollSuccess) {
+        fprintf(stderr, "%s failed on rank %d\n", config.collective.name, global_rank);
+        exit(1);
+      }
+      auto stop = std::chrono::steady_clock::now();
+      if (iter >= 0)
+        latencies[iter] = std::chrono::duration<double, std::micro>(stop - start).count();
+    }
+  }
+
+  collCommDestroy(&comm);
+  return nullptr;
+}
+
+double percentile(const std::vector<double>& sorted, double p)
+{
+  size_t idx = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+  return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+void report(const BenchState& state, const std::vector<Config>& configs, int iters)
+{
+  int total_size = state.nb_threads * state.mpi_comm_size;
+  for (size_t idx = 0; idx < configs.size(); idx++) {
+    const Config& config = configs[idx];
+    // The latency of an iteration is that of its slowest rank
+    std::vector<double> slowest(iters, 0.0);
+    for (auto& latencies : state.latencies[idx])
+      for (int iter = 0; iter < iters; iter++)
+        slowest[iter] = std::max(slowest[iter], latencies[iter]);
+#ifdef LEGATE_USE_NETWORK
+    MPI_Allreduce(MPI_IN_PLACE, slowest.data(), iters, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+#endif
+    if (state.mpi_rank != 0) continue;
+
+    std::sort(slowest.begin(), slowest.end());
+    double p50       = percentile(slowest, 0.5);
+    double bandwidth = p50 > 0 ? received_bytes(config, total_size) / p50 / 1e3 : 0.0;
+#ifdef LEGATE_USE_NETWORK
+    const char* backend = "mpi";
+#else
+    const char* backend = "local";
+#endif
+    printf("%s,%s,%s,%d,%d,%zu,%d,%.2f,%.2f,%.2f,%.2f,%.2f,%.3f\n",
+           backend,
+           config.collective.name,
+           config.type.name,
+           state.mpi_comm_size,
+           total_size,
+           config.count * config.type.size,
+           iters,
+           slowest.front(),
+           p50,
+           percentile(slowest, 0.9),
+           percentile(slowest, 0.99),
+           slowest.back(),
+           bandwidth);
+  }
+  fflush(stdout);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  Options options = parse_options(argc, argv);
+
+  int mpi_rank = 0, mpi_comm_size = 1;
+#ifdef LEGATE_USE_NETWORK
+  int provided;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+  if (provided != MPI_THREAD_MULTIPLE) {
+    fprintf(stderr, "MPI does not support MPI_THREAD_MULTIPLE\n");
+    MPI_Abort(MPI_COMM_WORLD, 1);
+  }
+  MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &mpi_comm_size);
+#endif
+  collInit(argc, argv);
+
+  std::vector<Config> configs = make_configs(options);
+  for (auto& config : configs)
+    if (config.collective.kind == Collective::AlltoallLegacy && mpi_comm_size > 1) {
+      if (mpi_rank == 0) fprintf(stderr, "alltoall_legacy only runs within a single process\n");
+      collFinalize();
+#ifdef LEGATE_USE_NETWORK
+      MPI_Finalize();
+#endif
+      return 1;
+    }
+  if (mpi_rank == 0)
+    printf(
+      "backend,collective,dtype,processes,ranks,bytes,iters,min_us,p50_us,p90_us,p99_us,max_us,"
+      "bandwidth_GBps\n");
+
+  for (int nb_threads : options.threads) {
+    BenchState state;
+    state.options       = &options;
+    state.configs       = &configs;
+    state.nb_threads    = nb_threads;
+    state.mpi_rank      = mpi_rank;
+    state.mpi_comm_size = mpi_comm_size;
+    state.unique_id     = collInitComm();
+    state.latencies.assign(configs.size(), std::vector<std::vector<double>>(nb_threads));
+    pthread_barrier_init(&state.legacy.barrier, nullptr, nb_threads);
+    state.legacy.buffers.reset(new std::atomic<const void*>[nb_threads]);
+    for (int i = 0; i < nb_threads; i++) state.legacy.buffers[i].store(nullptr);
+
+    std::vector<pthread_t> threads(nb_threads);
+    std::vector<WorkerArgs> args(nb_threads);
+    for (int i = 0; i < nb_threads; i++) {
+      args[i] = WorkerArgs{&state, i};
+      pthread_create(&threads[i], nullptr, worker, &args[i]);
+    }
+    for (int i = 0; i < nb_threads; i++) pthread_join(threads[i], nullptr);
+    report(state, configs, options.iters);
+    pthread_barrier_destroy(&state.legacy.barrier);
+  }
+
+  collFinalize();
+#ifdef LEGATE_USE_NETWORK
+  MPI_Finalize();
+#endif
+  return 0;
+}
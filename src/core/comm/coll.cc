@@ -19,14 +19,26 @@
 #include <pthread.h>
 #include <stdio.h>
 #include <string.h>
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <cstdlib>
+#include <mutex>
 #include <unordered_map>
 
+#include <thread>
+
 #ifndef LEGATE_USE_NETWORK
 #include <stdint.h>
 #endif
 
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #include "coll.h"
 #include "legate.h"
 #include "legion.h"
@@ -41,29 +53,180 @@ Logger log_coll("coll");
 #ifdef LEGATE_USE_NETWORK
 
 enum CollTag : int {
-  BCAST_TAG     = 0,
-  GATHER_TAG    = 1,
-  ALLTOALL_TAG  = 2,
-  ALLTOALLV_TAG = 3,
-  MAX_TAG       = 10,
+  BCAST_TAG          = 0,
+  GATHER_TAG         = 1,
+  ALLTOALL_TAG       = 2,
+  ALLTOALLV_TAG      = 3,
+  ALLREDUCE_TAG      = 4,
+  REDUCE_TAG         = 5,
+  REDUCE_SCATTER_TAG = 6,
+  IALLTOALLV_TAG     = 7,
+  IALLGATHER_TAG     = 8,
+  IALLREDUCE_TAG     = 9,
+  BCAST_RING_TAG     = 10,
+  ALLGATHERV_TAG     = 11,
+  MAX_TAG            = 16,
 };
 
 static int mpi_tag_ub = 0;
 
 static std::vector<MPI_Comm> mpi_comms;
-#else  // undef LEGATE_USE_NETWORK
-static std::vector<ThreadComm*> thread_comms;
 #endif
 
+// Shared-memory state of each communicator, one per process
+static std::vector<ThreadComm*> thread_comms;
+
+// Number of polls of a peer's slot before a waiting rank goes to sleep on it
+static constexpr int LOCAL_SPIN_COUNT = 1 << 8;
+
 static int current_unique_id = 0;
 
 static bool coll_inited = false;
 
+// Fixed-size opaque types registered with collTypeRegister
+struct UserType {
+  size_t size;
+#ifdef LEGATE_USE_NETWORK
+  MPI_Datatype mpi_type;
+#endif
+};
+
+static constexpr int MAX_USER_TYPES = 256;
+
+// Entries are written before the count is published, so collectives can look them up without
+// taking the lock
+static UserType user_types[MAX_USER_TYPES];
+static std::atomic<int> nb_user_types{0};
+static std::mutex user_types_lock;
+
+// Telemetry of the collectives, collected when LEGATE_COLL_STATS is set. The statistics of the
+// live communicators are summed with those of the destroyed ones whenever they are queried.
+static bool stats_enabled = false;
+static std::mutex stats_lock;
+static std::vector<CollStats*> live_stats;
+static legate_cpucoll_stats_t retired_stats[LEGATE_CPUCOLL_NUM_KINDS];
+
+// Time the calling rank has spent blocked on its peers, in waitLocal or in blocking MPI calls
+static thread_local uint64_t local_wait_ns = 0;
+// Set while the calling rank runs a collective whose communicator collects statistics
+static thread_local bool timing_waits = false;
+
+// Counts and displacements that the collectives build for their int64_t variants, such as the
+// widened arguments of the int variants. Kept across calls, so that a rank only allocates when
+// its communicators grow.
+static thread_local std::vector<int64_t> count_scratch;
+
+static const char* const COLL_KIND_NAMES[LEGATE_CPUCOLL_NUM_KINDS] = {"Alltoallv",
+                                                                     "Alltoall",
+                                                                     "Allgather",
+                                                                     "Bcast",
+                                                                     "Gather",
+                                                                     "Allreduce",
+                                                                     "Reduce",
+                                                                     "ReduceScatter",
+                                                                     "Ialltoallv",
+                                                                     "Iallgather",
+                                                                     "Iallreduce",
+                                                                     "Allgatherv"};
+
 // functions start here
 #ifdef LEGATE_USE_NETWORK
 static inline std::pair<int, int> mostFrequent(const int* arr, int n);
 static inline int match2ranks(int rank1, int rank2, CollComm global_comm);
 #endif
+static inline const UserType& getUserType(CollDataType dtype);
+static inline ThreadComm* getLocalComm(CollComm global_comm);
+static inline int getLocalRank(CollComm global_comm);
+static inline int getLocalCommSize(CollComm global_comm);
+static inline int getGlobalRankOfLocal(CollComm global_comm, int local_rank);
+#ifdef LEGATE_USE_NETWORK
+static void setupComm(CollComm global_comm,
+                      MPI_Comm comm,
+                      const int* mapping_table,
+                      ThreadComm* thread_comm);
+#else
+static void setupComm(CollComm global_comm, ThreadComm* thread_comm);
+#endif
+static ThreadComm* createThreadComm();
+static void releaseThreadComm(ThreadComm* thread_comm);
+static void attachLocalComm(CollComm global_comm, ThreadComm* thread_comm);
+static void detachLocalComm(CollComm global_comm);
+static void attachStats(CollComm global_comm);
+static void retireStats(CollComm global_comm);
+static void accumulateStats(legate_cpucoll_stats_t* total, const CollKindStats& stats);
+static inline uint64_t nowNs();
+static inline int64_t* getCountScratch(size_t size);
+
+// Accounts a collective call to the telemetry of its communicator, from construction to
+// destruction. Sizes are in elements of the collective's datatype.
+class CollStatsScope {
+ public:
+  CollStatsScope(CollComm global_comm, legate_cpucoll_kind_t kind, CollDataType type)
+    : stats_(global_comm->stats != nullptr ? &global_comm->stats->kinds[kind] : nullptr),
+      type_(type)
+  {
+    if (stats_ == nullptr) { return; }
+    start_ns_           = nowNs();
+    start_wait_ns_      = local_wait_ns;
+    outer_timing_waits_ = timing_waits;
+    timing_waits        = true;
+  }
+  ~CollStatsScope()
+  {
+    if (stats_ == nullptr) { return; }
+    timing_waits     = outer_timing_waits_;
+    uint64_t wait_ns = local_wait_ns - start_wait_ns_;
+    add(stats_->calls, 1);
+    add(stats_->time_ns, nowNs() - start_ns_);
+    add(stats_->wait_ns, wait_ns);
+    uint64_t max_skew_ns = stats_->max_skew_ns.load(std::memory_order_relaxed);
+    while (wait_ns > max_skew_ns &&
+           !stats_->max_skew_ns.compare_exchange_weak(
+             max_skew_ns, wait_ns, std::memory_order_relaxed)) {}
+  }
+  CollStatsScope(const CollStatsScope&)            = delete;
+  CollStatsScope& operator=(const CollStatsScope&) = delete;
+
+  void countBytes(int64_t sent, int64_t received)
+  {
+    if (stats_ == nullptr) { return; }
+    uint64_t type_size = typeSize();
+    add(stats_->bytes_sent, sent * type_size);
+    add(stats_->bytes_received, received * type_size);
+  }
+
+ private:
+  // Only the owning rank updates its counters
+  static void add(std::atomic<uint64_t>& counter, uint64_t value)
+  {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+  }
+  uint64_t typeSize() const
+  {
+#ifdef LEGATE_USE_NETWORK
+    MPI_Aint lb, type_extent;
+    MPI_Type_get_extent(dtypeToMPIDtype(type_), &lb, &type_extent);
+    return type_extent;
+#else
+    return getDtypeSize(type_);
+#endif
+  }
+
+ private:
+  CollKindStats* stats_;
+  CollDataType type_;
+  uint64_t start_ns_{0};
+  uint64_t start_wait_ns_{0};
+  bool outer_timing_waits_{false};
+};
+
+// What the local ranks of a derived communicator share
+struct DerivedCommState {
+#ifdef LEGATE_USE_NETWORK
+  MPI_Comm comm;
+#endif
+  ThreadComm* thread_comm;
+};
 
 int collCommCreate(CollComm global_comm,
                    int global_comm_size,
@@ -75,62 +238,124 @@ int collCommCreate(CollComm global_comm,
   global_comm->global_rank      = global_rank;
   global_comm->status           = true;
   global_comm->unique_id        = unique_id;
+  global_comm->derived          = false;
 #ifdef LEGATE_USE_NETWORK
-  int mpi_rank, mpi_comm_size;
-  int *tag_ub, flag;
   int compare_result;
   MPI_Comm comm = mpi_comms[unique_id];
   CHECK_MPI(MPI_Comm_compare(comm, MPI_COMM_WORLD, &compare_result));
   assert(MPI_CONGRUENT == compare_result);
-
-  CHECK_MPI(MPI_Comm_rank(comm, &mpi_rank));
-  CHECK_MPI(MPI_Comm_size(comm, &mpi_comm_size));
-  global_comm->mpi_comm_size = mpi_comm_size;
-  global_comm->mpi_rank      = mpi_rank;
-  global_comm->comm          = comm;
-  assert(mapping_table != nullptr);
-  global_comm->mapping_table.global_rank = (int*)malloc(sizeof(int) * global_comm_size);
-  global_comm->mapping_table.mpi_rank    = (int*)malloc(sizeof(int) * global_comm_size);
-  memcpy(global_comm->mapping_table.mpi_rank, mapping_table, sizeof(int) * global_comm_size);
-  for (int i = 0; i < global_comm_size; i++) { global_comm->mapping_table.global_rank[i] = i; }
-  std::pair<int, int> p             = mostFrequent(mapping_table, global_comm_size);
-  global_comm->nb_threads           = p.first;
-  global_comm->mpi_comm_size_actual = p.second;
+  setupComm(global_comm, comm, mapping_table, thread_comms[unique_id]);
 #else
   assert(mapping_table == nullptr);
-  global_comm->mpi_comm_size        = 1;
-  global_comm->mpi_comm_size_actual = 1;
-  global_comm->mpi_rank             = 0;
-  if (global_comm->global_rank == 0) {
-    pthread_barrier_init((pthread_barrier_t*)&(thread_comms[global_comm->unique_id]->barrier),
-                         nullptr,
-                         global_comm->global_comm_size);
-    thread_comms[global_comm->unique_id]->buffers =
-      (const void**)malloc(sizeof(void*) * global_comm_size);
-    thread_comms[global_comm->unique_id]->displs =
-      (const int**)malloc(sizeof(int*) * global_comm_size);
-    for (int i = 0; i < global_comm_size; i++) {
-      thread_comms[global_comm->unique_id]->buffers[i] = nullptr;
-      thread_comms[global_comm->unique_id]->displs[i]  = nullptr;
-    }
-    __sync_synchronize();
-    thread_comms[global_comm->unique_id]->ready_flag = true;
-  }
-  __sync_synchronize();
-  volatile ThreadComm* data = thread_comms[global_comm->unique_id];
-  while (data->ready_flag != true) { data = thread_comms[global_comm->unique_id]; }
-  global_comm->comm = thread_comms[global_comm->unique_id];
+  setupComm(global_comm, thread_comms[unique_id]);
+#endif
+  return CollSuccess;
+}
+
+int collCommSplit(CollComm global_comm, int color, int key, CollComm new_comm)
+{
+  int total_size  = global_comm->global_comm_size;
+  int global_rank = global_comm->global_rank;
+
+  // Every rank learns the color and key of all the others
+  int color_key[2] = {color, key};
+  std::vector<int> color_keys(2 * total_size);
+  collAllgather(color_key, color_keys.data(), 2, CollDataType::CollInt, global_comm);
+
+  std::vector<int> members;
+  for (int i = 0; i < total_size; i++) {
+    if (color != CollUndefined && color_keys[2 * i] == color) { members.push_back(i); }
+  }
+  std::stable_sort(members.begin(), members.end(), [&](int a, int b) {
+    return color_keys[2 * a + 1] < color_keys[2 * b + 1];
+  });
+
+  // The first local rank of each color creates the state that the local ranks of that color
+  // share, and hands it to the others through the mailbox of the parent communicator
+  int local_rank = getLocalRank(global_comm);
+  int leader     = -1;
+  for (int i = 0; i < getLocalCommSize(global_comm) && !members.empty(); i++) {
+    if (color_keys[2 * getGlobalRankOfLocal(global_comm, i)] == color) {
+      leader = i;
+      break;
+    }
+  }
+  DerivedCommState state;
+#ifdef LEGATE_USE_NETWORK
+  // Processes hosting the new communicator, in rank order of the parent MPI communicator
+  std::vector<int> mpi_ranks;
+  for (int member : members) { mpi_ranks.push_back(global_comm->mapping_table.mpi_rank[member]); }
+  std::sort(mpi_ranks.begin(), mpi_ranks.end());
+  mpi_ranks.erase(std::unique(mpi_ranks.begin(), mpi_ranks.end()), mpi_ranks.end());
+#endif
+  if (leader == local_rank) {
+    state.thread_comm = createThreadComm();
+#ifdef LEGATE_USE_NETWORK
+    // Concurrent group creations on the same communicator need distinct tags, so colors are
+    // numbered from the top of the tag space, out of the way of the collectives
+    std::vector<int> colors;
+    for (int i = 0; i < total_size; i++) {
+      if (color_keys[2 * i] != CollUndefined) { colors.push_back(color_keys[2 * i]); }
+    }
+    std::sort(colors.begin(), colors.end());
+    colors.erase(std::unique(colors.begin(), colors.end()), colors.end());
+    int tag = mpi_tag_ub - (std::lower_bound(colors.begin(), colors.end(), color) - colors.begin());
+    MPI_Group parent_group, group;
+    CHECK_MPI(MPI_Comm_group(global_comm->comm, &parent_group));
+    CHECK_MPI(MPI_Group_incl(parent_group, mpi_ranks.size(), mpi_ranks.data(), &group));
+    CHECK_MPI(MPI_Comm_create_group(global_comm->comm, group, tag, &state.comm));
+    CHECK_MPI(MPI_Group_free(&group));
+    CHECK_MPI(MPI_Group_free(&parent_group));
+#endif
+    publishLocalBuffer(global_comm, &state);
+  } else {
+    publishLocalBuffer(global_comm, nullptr);
+    if (leader != -1) {
+      waitLocal(global_comm, leader);
+      const void* buffer = getLocalComm(global_comm)->slots[leader].buffer;
+      state              = *static_cast<const DerivedCommState*>(buffer);
+    }
+  }
+  // Keep the state of the leader alive until every local rank has copied it
   barrierLocal(global_comm);
-  assert(global_comm->comm->ready_flag == true);
-  assert(global_comm->comm->buffers != nullptr);
-  assert(global_comm->comm->displs != nullptr);
-  global_comm->nb_threads = global_comm->global_comm_size;
+
+  new_comm->unique_id = global_comm->unique_id;
+  new_comm->derived   = true;
+  if (members.empty()) {
+    new_comm->global_comm_size = 0;
+    new_comm->global_rank      = -1;
+    new_comm->status           = false;
+    return CollSuccess;
+  }
+  new_comm->global_comm_size = members.size();
+  new_comm->global_rank =
+    std::find(members.begin(), members.end(), global_rank) - members.begin();
+  new_comm->status = true;
+#ifdef LEGATE_USE_NETWORK
+  std::vector<int> mapping_table;
+  for (int member : members) {
+    int mpi_rank = global_comm->mapping_table.mpi_rank[member];
+    mapping_table.push_back(std::lower_bound(mpi_ranks.begin(), mpi_ranks.end(), mpi_rank) -
+                            mpi_ranks.begin());
+  }
+  setupComm(new_comm, state.comm, mapping_table.data(), state.thread_comm);
+#else
+  setupComm(new_comm, state.thread_comm);
 #endif
+  log_coll.debug("Split comm id %d: global_rank %d -> rank %d of %d with color %d",
+                 global_comm->unique_id,
+                 global_rank,
+                 new_comm->global_rank,
+                 new_comm->global_comm_size,
+                 color);
   return CollSuccess;
 }
 
 int collCommDestroy(CollComm global_comm)
 {
+  if (!global_comm->status) { return CollSuccess; }
+  retireStats(global_comm);
+  ThreadComm* thread_comm = getLocalComm(global_comm);
 #ifdef LEGATE_USE_NETWORK
   if (global_comm->mapping_table.global_rank != nullptr) {
     free(global_comm->mapping_table.global_rank);
@@ -140,21 +365,22 @@ int collCommDestroy(CollComm global_comm)
     free(global_comm->mapping_table.mpi_rank);
     global_comm->mapping_table.mpi_rank = nullptr;
   }
+  if (global_comm->mapping_table.local_index != nullptr) {
+    free(global_comm->mapping_table.local_index);
+    global_comm->mapping_table.local_index = nullptr;
+  }
+  detachLocalComm(global_comm);
+  if (global_comm->derived && global_comm->local_rank == 0) {
+    CHECK_MPI(MPI_Comm_free(&global_comm->comm));
+  }
+  if (global_comm->local_ranks != nullptr) {
+    free(global_comm->local_ranks);
+    global_comm->local_ranks = nullptr;
+  }
 #else
-  barrierLocal(global_comm);
-  if (global_comm->global_rank == 0) {
-    pthread_barrier_destroy((pthread_barrier_t*)&(thread_comms[global_comm->unique_id]->barrier));
-    free(thread_comms[global_comm->unique_id]->buffers);
-    thread_comms[global_comm->unique_id]->buffers = nullptr;
-    free(thread_comms[global_comm->unique_id]->displs);
-    thread_comms[global_comm->unique_id]->displs = nullptr;
-    __sync_synchronize();
-    thread_comms[global_comm->unique_id]->ready_flag = false;
-  }
-  __sync_synchronize();
-  volatile ThreadComm* data = thread_comms[global_comm->unique_id];
-  while (data->ready_flag != false) { data = thread_comms[global_comm->unique_id]; }
+  detachLocalComm(global_comm);
 #endif
+  if (global_comm->derived) { releaseThreadComm(thread_comm); }
   global_comm->status = false;
   return CollSuccess;
 }
@@ -168,10 +394,70 @@ int collAlltoallv(const void* sendbuf,
                   CollDataType type,
                   CollComm global_comm)
 {
-  // IN_PLACE
-  if (sendbuf == recvbuf) {
-    log_coll.error("Do not support inplace Alltoallv");
-    LEGATE_ABORT;
+  int total_size = global_comm->global_comm_size;
+  int64_t* large = getCountScratch(4 * total_size);
+  std::copy(sendcounts, sendcounts + total_size, large);
+  std::copy(sdispls, sdispls + total_size, large + total_size);
+  std::copy(recvcounts, recvcounts + total_size, large + 2 * total_size);
+  std::copy(rdispls, rdispls + total_size, large + 3 * total_size);
+  return collAlltoallvLarge(sendbuf,
+                            large,
+                            large + total_size,
+                            recvbuf,
+                            large + 2 * total_size,
+                            large + 3 * total_size,
+                            type,
+                            global_comm);
+}
+
+int collAlltoall(
+  const void* sendbuf, void* recvbuf, int count, CollDataType type, CollComm global_comm)
+{
+  return collAlltoallLarge(sendbuf, recvbuf, count, type, global_comm);
+}
+
+int collAllgather(
+  const void* sendbuf, void* recvbuf, int count, CollDataType type, CollComm global_comm)
+{
+  return collAllgatherLarge(sendbuf, recvbuf, count, type, global_comm);
+}
+
+int collAllgatherv(const void* sendbuf,
+                   int sendcount,
+                   void* recvbuf,
+                   const int recvcounts[],
+                   const int displs[],
+                   CollDataType type,
+                   CollComm global_comm)
+{
+  int total_size = global_comm->global_comm_size;
+  int64_t* large = getCountScratch(2 * total_size);
+  std::copy(recvcounts, recvcounts + total_size, large);
+  std::copy(displs, displs + total_size, large + total_size);
+  return collAllgathervLarge(
+    sendbuf, sendcount, recvbuf, large, large + total_size, type, global_comm);
+}
+
+int collAlltoallvLarge(const void* sendbuf,
+                       const int64_t sendcounts[],
+                       const int64_t sdispls[],
+                       void* recvbuf,
+                       const int64_t recvcounts[],
+                       const int64_t rdispls[],
+                       CollDataType type,
+                       CollComm global_comm)
+{
+  CollStatsScope stats(global_comm, LEGATE_CPUCOLL_ALLTOALLV, type);
+  if (global_comm->stats != nullptr) {
+    int total_size = global_comm->global_comm_size;
+    int64_t sent   = 0;
+    int64_t recvd  = 0;
+    for (int i = 0; i < total_size; i++) {
+      sent += sendcounts[i];
+      recvd += recvcounts[i];
+    }
+    // In-place calls only describe the receive side, which is the same as the send side
+    stats.countBytes(sendbuf == recvbuf ? recvd : sent, recvd);
   }
   log_coll.debug(
     "Alltoallv: global_rank %d, mpi_rank %d, unique_id %d, comm_size %d, "
@@ -183,6 +469,14 @@ int collAlltoallv(const void* sendbuf,
     global_comm->mpi_comm_size,
     global_comm->mpi_comm_size_actual,
     global_comm->nb_threads);
+  // IN_PLACE
+  if (sendbuf == recvbuf) {
+#ifdef LEGATE_USE_NETWORK
+    return alltoallvInplaceMPI(recvbuf, recvcounts, rdispls, type, global_comm);
+#else
+    return alltoallvInplaceLocal(recvbuf, recvcounts, rdispls, type, global_comm);
+#endif
+  }
 #ifdef LEGATE_USE_NETWORK
   return alltoallvMPI(
     sendbuf, sendcounts, sdispls, recvbuf, recvcounts, rdispls, type, global_comm);
@@ -192,14 +486,11 @@ int collAlltoallv(const void* sendbuf,
 #endif
 }
 
-int collAlltoall(
-  const void* sendbuf, void* recvbuf, int count, CollDataType type, CollComm global_comm)
+int collAlltoallLarge(
+  const void* sendbuf, void* recvbuf, int64_t count, CollDataType type, CollComm global_comm)
 {
-  // IN_PLACE
-  if (sendbuf == recvbuf) {
-    log_coll.error("Do not support inplace Alltoall");
-    LEGATE_ABORT;
-  }
+  CollStatsScope stats(global_comm, LEGATE_CPUCOLL_ALLTOALL, type);
+  stats.countBytes(count * global_comm->global_comm_size, count * global_comm->global_comm_size);
   log_coll.debug(
     "Alltoall: global_rank %d, mpi_rank %d, unique_id %d, comm_size %d, "
     "mpi_comm_size %d %d, nb_threads %d",
@@ -210,6 +501,21 @@ int collAlltoall(
     global_comm->mpi_comm_size,
     global_comm->mpi_comm_size_actual,
     global_comm->nb_threads);
+  // IN_PLACE: the blocks are swapped pairwise, as for an Alltoallv with uniform counts
+  if (sendbuf == recvbuf) {
+    int total_size  = global_comm->global_comm_size;
+    int64_t* counts = getCountScratch(2 * total_size);
+    int64_t* displs = counts + total_size;
+    for (int i = 0; i < total_size; i++) {
+      counts[i] = count;
+      displs[i] = i * count;
+    }
+#ifdef LEGATE_USE_NETWORK
+    return alltoallvInplaceMPI(recvbuf, counts, displs, type, global_comm);
+#else
+    return alltoallvInplaceLocal(recvbuf, counts, displs, type, global_comm);
+#endif
+  }
 #ifdef LEGATE_USE_NETWORK
   return alltoallMPI(sendbuf, recvbuf, count, type, global_comm);
 #else
@@ -217,9 +523,11 @@ int collAlltoall(
 #endif
 }
 
-int collAllgather(
-  const void* sendbuf, void* recvbuf, int count, CollDataType type, CollComm global_comm)
+int collAllgatherLarge(
+  const void* sendbuf, void* recvbuf, int64_t count, CollDataType type, CollComm global_comm)
 {
+  CollStatsScope stats(global_comm, LEGATE_CPUCOLL_ALLGATHER, type);
+  stats.countBytes(count, count * global_comm->global_comm_size);
   log_coll.debug(
     "Allgather: global_rank %d, mpi_rank %d, unique_id %d, comm_size %d, "
     "mpi_comm_size %d %d, nb_threads %d",
@@ -237,152 +545,504 @@ int collAllgather(
 #endif
 }
 
-// called from main thread
-int collInit(int argc, char* argv[])
+int collAllgathervLarge(const void* sendbuf,
+                        int64_t sendcount,
+                        void* recvbuf,
+                        const int64_t recvcounts[],
+                        const int64_t displs[],
+                        CollDataType type,
+                        CollComm global_comm)
 {
-  current_unique_id = 0;
-#ifdef LEGATE_USE_NETWORK
-  int provided, init_flag = 0;
-  CHECK_MPI(MPI_Initialized(&init_flag));
-  if (!init_flag) {
-    log_coll.fatal(
-      "MPI has not been initialized, it should be initialized by "
-      "the networking backend");
+  CollStatsScope stats(global_comm, LEGATE_CPUCOLL_ALLGATHERV, type);
+  if (global_comm->stats != nullptr) {
+    int64_t recvd = 0;
+    for (int i = 0; i < global_comm->global_comm_size; i++) { recvd += recvcounts[i]; }
+    stats.countBytes(sendcount, recvd);
+  }
+  log_coll.debug(
+    "Allgatherv: global_rank %d, mpi_rank %d, unique_id %d, comm_size %d, "
+    "mpi_comm_size %d %d, nb_threads %d",
+    global_comm->global_rank,
+    global_comm->mpi_rank,
+    global_comm->unique_id,
+    global_comm->global_comm_size,
+    global_comm->mpi_comm_size,
+    global_comm->mpi_comm_size_actual,
+    global_comm->nb_threads);
+  if (sendbuf != recvbuf && sendcount != recvcounts[global_comm->global_rank]) {
+    log_coll.error("Allgatherv: rank %d sends %lld elements but recvcounts says %lld",
+                   global_comm->global_rank,
+                   static_cast<long long>(sendcount),
+                   static_cast<long long>(recvcounts[global_comm->global_rank]));
     LEGATE_ABORT;
-  } else {
-    int mpi_thread_model;
-    MPI_Query_thread(&mpi_thread_model);
-    if (mpi_thread_model != MPI_THREAD_MULTIPLE) {
-      log_coll.fatal(
-        "MPI has been initialized by others, but is not initialized with "
-        "MPI_THREAD_MULTIPLE");
-      LEGATE_ABORT;
-    }
   }
-  // check
-  int *tag_ub, flag;
-  CHECK_MPI(MPI_Comm_get_attr(MPI_COMM_WORLD, MPI_TAG_UB, &tag_ub, &flag));
-  assert(flag);
-  mpi_tag_ub = *tag_ub;
-  assert(mpi_comms.empty());
+#ifdef LEGATE_USE_NETWORK
+  return allgathervMPI(sendbuf, sendcount, recvbuf, recvcounts, displs, type, global_comm);
 #else
-  assert(thread_comms.empty());
+  return allgathervLocal(sendbuf, sendcount, recvbuf, recvcounts, displs, type, global_comm);
 #endif
-  coll_inited = true;
-  return CollSuccess;
 }
 
-int collFinalize()
+int collBcast(void* buf, int count, CollDataType type, int root, CollComm global_comm)
 {
-  assert(coll_inited == true);
-  coll_inited = false;
+  CollStatsScope stats(global_comm, LEGATE_CPUCOLL_BCAST, type);
+  bool is_root = global_comm->global_rank == root;
+  stats.countBytes(is_root ? count : 0, is_root ? 0 : count);
+  log_coll.debug(
+    "Bcast: global_rank %d, mpi_rank %d, unique_id %d, comm_size %d, "
+    "mpi_comm_size %d %d, nb_threads %d, root %d",
+    global_comm->global_rank,
+    global_comm->mpi_rank,
+    global_comm->unique_id,
+    global_comm->global_comm_size,
+    global_comm->mpi_comm_size,
+    global_comm->mpi_comm_size_actual,
+    global_comm->nb_threads,
+    root);
 #ifdef LEGATE_USE_NETWORK
-  for (MPI_Comm& mpi_comm : mpi_comms) { CHECK_MPI(MPI_Comm_free(&mpi_comm)); }
-  mpi_comms.clear();
-  int fina_flag = 0;
-  CHECK_MPI(MPI_Finalized(&fina_flag));
-  if (fina_flag == 1) {
-    log_coll.fatal("MPI should not have been finalized");
+  return bcastMPI(buf, count, type, root, global_comm);
+#else
+  return bcastLocal(buf, count, type, root, global_comm);
+#endif
+}
+
+int collGather(const void* sendbuf,
+               void* recvbuf,
+               int count,
+               CollDataType type,
+               int root,
+               CollComm global_comm)
+{
+  // IN_PLACE
+  if (sendbuf == recvbuf) {
+    log_coll.error("Do not support inplace Gather");
     LEGATE_ABORT;
   }
+  CollStatsScope stats(global_comm, LEGATE_CPUCOLL_GATHER, type);
+  bool is_root = global_comm->global_rank == root;
+  stats.countBytes(count, is_root ? static_cast<int64_t>(count) * global_comm->global_comm_size : 0);
+  log_coll.debug(
+    "Gather: global_rank %d, mpi_rank %d, unique_id %d, comm_size %d, "
+    "mpi_comm_size %d %d, nb_threads %d, root %d",
+    global_comm->global_rank,
+    global_comm->mpi_rank,
+    global_comm->unique_id,
+    global_comm->global_comm_size,
+    global_comm->mpi_comm_size,
+    global_comm->mpi_comm_size_actual,
+    global_comm->nb_threads,
+    root);
+#ifdef LEGATE_USE_NETWORK
+  return gatherMPI(sendbuf, recvbuf, count, type, root, global_comm);
 #else
-  for (ThreadComm* thread_comm : thread_comms) {
-    assert(!thread_comm->ready_flag);
-    free(thread_comm);
-  }
-  thread_comms.clear();
+  return gatherLocal(sendbuf, recvbuf, count, type, root, global_comm);
 #endif
-  return CollSuccess;
 }
 
-int collGetUniqueId(int* id)
+int collAllreduce(const void* sendbuf,
+                  void* recvbuf,
+                  int count,
+                  CollDataType type,
+                  CollReductionOp op,
+                  CollComm global_comm)
 {
-  *id = current_unique_id;
-  current_unique_id++;
-  return CollSuccess;
+  CollStatsScope stats(global_comm, LEGATE_CPUCOLL_ALLREDUCE, type);
+  stats.countBytes(count, count);
+  log_coll.debug(
+    "Allreduce: global_rank %d, mpi_rank %d, unique_id %d, comm_size %d, "
+    "mpi_comm_size %d %d, nb_threads %d",
+    global_comm->global_rank,
+    global_comm->mpi_rank,
+    global_comm->unique_id,
+    global_comm->global_comm_size,
+    global_comm->mpi_comm_size,
+    global_comm->mpi_comm_size_actual,
+    global_comm->nb_threads);
+#ifdef LEGATE_USE_NETWORK
+  return allreduceMPI(sendbuf, recvbuf, count, type, op, global_comm);
+#else
+  return allreduceLocal(sendbuf, recvbuf, count, type, op, global_comm);
+#endif
 }
 
-int collInitComm()
+int collReduce(const void* sendbuf,
+               void* recvbuf,
+               int count,
+               CollDataType type,
+               CollReductionOp op,
+               int root,
+               CollComm global_comm)
 {
-  int id = 0;
-  collGetUniqueId(&id);
+  CollStatsScope stats(global_comm, LEGATE_CPUCOLL_REDUCE, type);
+  stats.countBytes(count, global_comm->global_rank == root ? count : 0);
+  log_coll.debug(
+    "Reduce: global_rank %d, mpi_rank %d, unique_id %d, comm_size %d, "
+    "mpi_comm_size %d %d, nb_threads %d, root %d",
+    global_comm->global_rank,
+    global_comm->mpi_rank,
+    global_comm->unique_id,
+    global_comm->global_comm_size,
+    global_comm->mpi_comm_size,
+    global_comm->mpi_comm_size_actual,
+    global_comm->nb_threads,
+    root);
 #ifdef LEGATE_USE_NETWORK
-#ifdef DEBUG_LEGATE
-  int mpi_rank;
-  int send_id = id;
-  // check if all ranks get the same unique id
-  CHECK_MPI(MPI_Bcast(&send_id, 1, MPI_INT, 0, MPI_COMM_WORLD));
-  assert(send_id == id);
-#endif
-  assert(mpi_comms.size() == id);
-  // create mpi comm
-  MPI_Comm mpi_comm;
-  CHECK_MPI(MPI_Comm_dup(MPI_COMM_WORLD, &mpi_comm));
-  mpi_comms.push_back(mpi_comm);
+  return reduceMPI(sendbuf, recvbuf, count, type, op, root, global_comm);
 #else
-  assert(thread_comms.size() == id);
-  // create thread comm
-  ThreadComm* thread_comm = (ThreadComm*)malloc(sizeof(ThreadComm));
-  thread_comm->ready_flag = false;
-  thread_comm->buffers    = nullptr;
-  thread_comm->displs     = nullptr;
-  thread_comms.push_back(thread_comm);
+  return reduceLocal(sendbuf, recvbuf, count, type, op, root, global_comm);
 #endif
-  log_coll.debug("Init comm id %d", id);
-  return id;
 }
 
-#ifdef LEGATE_USE_NETWORK
-static inline std::pair<int, int> mostFrequent(const int* arr, int n)
+int collReduceScatter(const void* sendbuf,
+                      void* recvbuf,
+                      int recvcount,
+                      CollDataType type,
+                      CollReductionOp op,
+                      CollComm global_comm)
 {
-  std::unordered_map<int, int> hash;
-  for (int i = 0; i < n; i++) hash[arr[i]]++;
-
-  // find the max frequency
-  int max_count = 0;
-  std::unordered_map<int, int>::iterator it;
-  for (it = hash.begin(); it != hash.end(); it++) {
-    if (max_count < it->second) { max_count = it->second; }
-  }
+  // IN_PLACE
+  if (sendbuf == recvbuf) {
+    log_coll.error("Do not support inplace ReduceScatter");
+    LEGATE_ABORT;
+  }
+  CollStatsScope stats(global_comm, LEGATE_CPUCOLL_REDUCE_SCATTER, type);
+  stats.countBytes(static_cast<int64_t>(recvcount) * global_comm->global_comm_size, recvcount);
+  log_coll.debug(
+    "ReduceScatter: global_rank %d, mpi_rank %d, unique_id %d, comm_size %d, "
+    "mpi_comm_size %d %d, nb_threads %d",
+    global_comm->global_rank,
+    global_comm->mpi_rank,
+    global_comm->unique_id,
+    global_comm->global_comm_size,
+    global_comm->mpi_comm_size,
+    global_comm->mpi_comm_size_actual,
+    global_comm->nb_threads);
+#ifdef LEGATE_USE_NETWORK
+  return reduceScatterMPI(sendbuf, recvbuf, recvcount, type, op, global_comm);
+#else
+  return reduceScatterLocal(sendbuf, recvbuf, recvcount, type, op, global_comm);
+#endif
+}
+
+int collIalltoallv(const void* sendbuf,
+                   const int sendcounts[],
+                   const int sdispls[],
+                   void* recvbuf,
+                   const int recvcounts[],
+                   const int rdispls[],
+                   CollDataType type,
+                   CollComm global_comm,
+                   CollRequest* request)
+{
+  // IN_PLACE
+  if (sendbuf == recvbuf) {
+    log_coll.error("Do not support inplace Ialltoallv");
+    LEGATE_ABORT;
+  }
+  CollStatsScope stats(global_comm, LEGATE_CPUCOLL_IALLTOALLV, type);
+  if (global_comm->stats != nullptr) {
+    int64_t sent  = 0;
+    int64_t recvd = 0;
+    for (int i = 0; i < global_comm->global_comm_size; i++) {
+      sent += sendcounts[i];
+      recvd += recvcounts[i];
+    }
+    stats.countBytes(sent, recvd);
+  }
+  log_coll.debug(
+    "Ialltoallv: global_rank %d, mpi_rank %d, unique_id %d, comm_size %d, "
+    "mpi_comm_size %d %d, nb_threads %d",
+    global_comm->global_rank,
+    global_comm->mpi_rank,
+    global_comm->unique_id,
+    global_comm->global_comm_size,
+    global_comm->mpi_comm_size,
+    global_comm->mpi_comm_size_actual,
+    global_comm->nb_threads);
+#ifdef LEGATE_USE_NETWORK
+  return ialltoallvMPI(
+    sendbuf, sendcounts, sdispls, recvbuf, recvcounts, rdispls, type, global_comm, request);
+#else
+  return ialltoallvLocal(
+    sendbuf, sendcounts, sdispls, recvbuf, recvcounts, rdispls, type, global_comm, request);
+#endif
+}
+
+int collIallgather(const void* sendbuf,
+                   void* recvbuf,
+                   int count,
+                   CollDataType type,
+                   CollComm global_comm,
+                   CollRequest* request)
+{
+  // IN_PLACE
+  if (sendbuf == recvbuf) {
+    log_coll.error("Do not support inplace Iallgather");
+    LEGATE_ABORT;
+  }
+  CollStatsScope stats(global_comm, LEGATE_CPUCOLL_IALLGATHER, type);
+  stats.countBytes(count, static_cast<int64_t>(count) * global_comm->global_comm_size);
+  log_coll.debug(
+    "Iallgather: global_rank %d, mpi_rank %d, unique_id %d, comm_size %d, "
+    "mpi_comm_size %d %d, nb_threads %d",
+    global_comm->global_rank,
+    global_comm->mpi_rank,
+    global_comm->unique_id,
+    global_comm->global_comm_size,
+    global_comm->mpi_comm_size,
+    global_comm->mpi_comm_size_actual,
+    global_comm->nb_threads);
+#ifdef LEGATE_USE_NETWORK
+  return iallgatherMPI(sendbuf, recvbuf, count, type, global_comm, request);
+#else
+  return iallgatherLocal(sendbuf, recvbuf, count, type, global_comm, request);
+#endif
+}
+
+int collIallreduce(const void* sendbuf,
+                   void* recvbuf,
+                   int count,
+                   CollDataType type,
+                   CollReductionOp op,
+                   CollComm global_comm,
+                   CollRequest* request)
+{
+  CollStatsScope stats(global_comm, LEGATE_CPUCOLL_IALLREDUCE, type);
+  stats.countBytes(count, count);
+  log_coll.debug(
+    "Iallreduce: global_rank %d, mpi_rank %d, unique_id %d, comm_size %d, "
+    "mpi_comm_size %d %d, nb_threads %d",
+    global_comm->global_rank,
+    global_comm->mpi_rank,
+    global_comm->unique_id,
+    global_comm->global_comm_size,
+    global_comm->mpi_comm_size,
+    global_comm->mpi_comm_size_actual,
+    global_comm->nb_threads);
+#ifdef LEGATE_USE_NETWORK
+  return iallreduceMPI(sendbuf, recvbuf, count, type, op, global_comm, request);
+#else
+  return iallreduceLocal(sendbuf, recvbuf, count, type, op, global_comm, request);
+#endif
+}
+
+int collTest(CollRequest* request, bool* completed)
+{
+  if (*request == nullptr) {
+    *completed = true;
+    return CollSuccess;
+  }
+#ifdef LEGATE_USE_NETWORK
+  return requestTestMPI(request, completed);
+#else
+  return requestTestLocal(request, completed);
+#endif
+}
+
+int collWait(CollRequest* request)
+{
+  if (*request == nullptr) { return CollSuccess; }
+#ifdef LEGATE_USE_NETWORK
+  return requestWaitMPI(request);
+#else
+  return requestWaitLocal(request);
+#endif
+}
+
+// called from main thread
+int collInit(int argc, char* argv[])
+{
+  current_unique_id = 0;
+#ifdef LEGATE_USE_NETWORK
+  int provided, init_flag = 0;
+  CHECK_MPI(MPI_Initialized(&init_flag));
+  if (!init_flag) {
+    log_coll.fatal(
+      "MPI has not been initialized, it should be initialized by "
+      "the networking backend");
+    LEGATE_ABORT;
+  } else {
+    int mpi_thread_model;
+    MPI_Query_thread(&mpi_thread_model);
+    if (mpi_thread_model != MPI_THREAD_MULTIPLE) {
+      log_coll.fatal(
+        "MPI has been initialized by others, but is not initialized with "
+        "MPI_THREAD_MULTIPLE");
+      LEGATE_ABORT;
+    }
+  }
+  // check
+  int *tag_ub, flag;
+  CHECK_MPI(MPI_Comm_get_attr(MPI_COMM_WORLD, MPI_TAG_UB, &tag_ub, &flag));
+  assert(flag);
+  mpi_tag_ub = *tag_ub;
+  assert(mpi_comms.empty());
+#endif
+  assert(thread_comms.empty());
+  stats_enabled = extract_env("LEGATE_COLL_STATS", 0, 0) != 0;
+  coll_inited   = true;
+  return CollSuccess;
+}
+
+int collFinalize()
+{
+  assert(coll_inited == true);
+  coll_inited = false;
+#ifdef LEGATE_USE_NETWORK
+  for (MPI_Comm& mpi_comm : mpi_comms) { CHECK_MPI(MPI_Comm_free(&mpi_comm)); }
+  mpi_comms.clear();
+  for (int i = 0; i < nb_user_types; i++) { CHECK_MPI(MPI_Type_free(&user_types[i].mpi_type)); }
+  int fina_flag = 0;
+  CHECK_MPI(MPI_Finalized(&fina_flag));
+  if (fina_flag == 1) {
+    log_coll.fatal("MPI should not have been finalized");
+    LEGATE_ABORT;
+  }
+#endif
+  for (ThreadComm* thread_comm : thread_comms) {
+    assert(!thread_comm->ready_flag);
+    delete thread_comm;
+  }
+  thread_comms.clear();
+  nb_user_types = 0;
+  if (stats_enabled) {
+    std::lock_guard<std::mutex> guard(stats_lock);
+    assert(live_stats.empty());
+    for (int kind = 0; kind < LEGATE_CPUCOLL_NUM_KINDS; kind++) {
+      const legate_cpucoll_stats_t& total = retired_stats[kind];
+      if (total.calls == 0) { continue; }
+      log_coll.print(
+        "%s: %llu calls, %llu bytes sent, %llu bytes received, %.6f s, %.6f s waiting, "
+        "max skew %.6f s",
+        COLL_KIND_NAMES[kind],
+        static_cast<unsigned long long>(total.calls),
+        static_cast<unsigned long long>(total.bytes_sent),
+        static_cast<unsigned long long>(total.bytes_received),
+        total.time,
+        total.wait_time,
+        total.max_skew);
+    }
+    memset(retired_stats, 0, sizeof(retired_stats));
+  }
+  return CollSuccess;
+}
+
+int collGetStats(int kind, legate_cpucoll_stats_t* stats)
+{
+  memset(stats, 0, sizeof(*stats));
+  if (!stats_enabled || kind < 0 || kind >= LEGATE_CPUCOLL_NUM_KINDS) { return 0; }
+  std::lock_guard<std::mutex> guard(stats_lock);
+  *stats = retired_stats[kind];
+  for (CollStats* live : live_stats) { accumulateStats(stats, live->kinds[kind]); }
+  return 1;
+}
+
+int collGetUniqueId(int* id)
+{
+  *id = current_unique_id;
+  current_unique_id++;
+  return CollSuccess;
+}
+
+int collInitComm()
+{
+  int id = 0;
+  collGetUniqueId(&id);
+#ifdef LEGATE_USE_NETWORK
+#ifdef DEBUG_LEGATE
+  int mpi_rank;
+  int send_id = id;
+  // check if all ranks get the same unique id
+  CHECK_MPI(MPI_Bcast(&send_id, 1, MPI_INT, 0, MPI_COMM_WORLD));
+  assert(send_id == id);
+#endif
+  assert(mpi_comms.size() == id);
+  // create mpi comm
+  MPI_Comm mpi_comm;
+  CHECK_MPI(MPI_Comm_dup(MPI_COMM_WORLD, &mpi_comm));
+  mpi_comms.push_back(mpi_comm);
+#endif
+  assert(thread_comms.size() == id);
+  // create thread comm
+  thread_comms.push_back(createThreadComm());
+  log_coll.debug("Init comm id %d", id);
+  return id;
+}
+
+CollDataType collDataTypeOf(legate_core_type_code_t code)
+{
+  switch (code) {
+    case BOOL_LT: return CollDataType::CollBool;
+    case INT8_LT: return CollDataType::CollInt8;
+    case INT16_LT: return CollDataType::CollInt16;
+    case INT32_LT: return CollDataType::CollInt;
+    case INT64_LT: return CollDataType::CollInt64;
+    case UINT8_LT: return CollDataType::CollUint8;
+    case UINT16_LT: return CollDataType::CollUint16;
+    case UINT32_LT: return CollDataType::CollUint32;
+    case UINT64_LT: return CollDataType::CollUint64;
+    case HALF_LT: return CollDataType::CollHalf;
+    case FLOAT_LT: return CollDataType::CollFloat;
+    case DOUBLE_LT: return CollDataType::CollDouble;
+    case COMPLEX64_LT: return CollDataType::CollComplex64;
+    case COMPLEX128_LT: return CollDataType::CollComplex128;
+    default: {
+      log_coll.fatal("Type code %d has no fixed-size collective datatype", static_cast<int>(code));
+      LEGATE_ABORT;
+      return CollDataType::CollInt8;
+    }
+  }
+}
+
+int collTypeRegister(size_t size, CollDataType* type)
+{
+  assert(coll_inited == true);
+  if (size == 0 || size > INT_MAX) {
+    log_coll.error("Cannot register a collective type of %zu bytes", size);
+    return CollError;
+  }
+  std::lock_guard<std::mutex> guard(user_types_lock);
+  int idx = nb_user_types.load(std::memory_order_relaxed);
+  if (idx == MAX_USER_TYPES) {
+    log_coll.error("Cannot register more than %d collective types", MAX_USER_TYPES);
+    return CollError;
+  }
+  UserType& user_type = user_types[idx];
+  user_type.size      = size;
+#ifdef LEGATE_USE_NETWORK
+  CHECK_MPI(MPI_Type_contiguous(static_cast<int>(size), MPI_BYTE, &user_type.mpi_type));
+  CHECK_MPI(MPI_Type_commit(&user_type.mpi_type));
+#endif
+  nb_user_types.store(idx + 1, std::memory_order_release);
+  *type = static_cast<CollDataType>(static_cast<int>(CollDataType::CollUserType) + idx);
+  log_coll.debug("Registered collective type %d of %zu bytes", static_cast<int>(*type), size);
+  return CollSuccess;
+}
+
+#ifdef LEGATE_USE_NETWORK
+static inline std::pair<int, int> mostFrequent(const int* arr, int n)
+{
+  std::unordered_map<int, int> hash;
+  for (int i = 0; i < n; i++) hash[arr[i]]++;
+
+  // find the max frequency
+  int max_count = 0;
+  std::unordered_map<int, int>::iterator it;
+  for (it = hash.begin(); it != hash.end(); it++) {
+    if (max_count < it->second) { max_count = it->second; }
+  }
 
   return std::make_pair(max_count, hash.size());
 }
 
 static inline int match2ranks(int rank1, int rank2, CollComm global_comm)
 {
-  // tag: seg idx + rank_idx + tag
-  // send_tag = sendto_global_rank * 10000 + global_rank (concat 2 ranks)
-  // which dst seg it sends to (in dst rank)
-  // recv_tag = global_rank * 10000 + recvfrom_global_rank (concat 2 ranks)
-  // idx of current seg we are receving (in src/my rank)
-  // example:
-  // 00 | 01 | 02 | 03
-  // 10 | 11 | 12 | 13
-  // 20 | 21 | 22 | 23
-  // 30 | 31 | 32 | 33
-  // 01's send_tag = 10, 10's recv_tag = 10, match
-  // 12's send_tag = 21, 21's recv_tag = 21, match
-
-  int tag;
-  // old tagging system for debug
-  // constexpr int const max_ranks = 10000;
-  // tag                           = rank1 * max_ranks + rank2;
-
-  // new tagging system, if crash, switch to the old one
-
-  tag = rank1 % global_comm->nb_threads * global_comm->global_comm_size + rank2;
-
-  // Szudzik's Function, two numbers < 32768
-  // if (rank1 >= rank2) {
-  //   tag = rank1*rank1 + rank1 + rank2;
-  // } else {
-  //   tag = rank1 + rank2*rank2;
-  // }
-
-  // Cantor Pairing Function, two numbers < 32768
-  // tag = (rank1 + rank2) * (rank1 + rank2 + 1) / 2 + rank1;
-
-  return tag;
+  // A message from rank2 to rank1 is matched on the MPI ranks of their processes, so the tag
+  // only needs to tell apart the ranks within each of the two processes. Building it from the
+  // local indices keeps the largest tag at nb_threads * nb_threads * MAX_TAG - 1, whatever the
+  // size of the communicator and however its ranks are laid out on the processes.
+  const int* local_index = global_comm->mapping_table.local_index;
+  return local_index[rank1] * global_comm->nb_threads + local_index[rank2];
 }
 
 MPI_Datatype dtypeToMPIDtype(CollDataType dtype)
@@ -415,14 +1075,139 @@ MPI_Datatype dtypeToMPIDtype(CollDataType dtype)
     case CollDataType::CollDouble: {
       return MPI_DOUBLE;
     }
+    case CollDataType::CollBool: {
+      return MPI_CXX_BOOL;
+    }
+    case CollDataType::CollInt16: {
+      return MPI_INT16_T;
+    }
+    case CollDataType::CollUint16: {
+      return MPI_UINT16_T;
+    }
+    case CollDataType::CollHalf: {
+      // Reductions are done by the collectives themselves, so MPI only needs the element size
+      return MPI_UINT16_T;
+    }
+    case CollDataType::CollComplex64: {
+      return MPI_CXX_FLOAT_COMPLEX;
+    }
+    case CollDataType::CollComplex128: {
+      return MPI_CXX_DOUBLE_COMPLEX;
+    }
     default: {
-      log_coll.fatal("Unknown datatype");
-      LEGATE_ABORT;
-      return MPI_BYTE;
+      return getUserType(dtype).mpi_type;
     }
   }
 }
 
+// Largest number of elements sent in one message when the large-count API is unavailable
+static constexpr int64_t MAX_MESSAGE_COUNT = INT_MAX;
+
+void isendLarge(const void* buf,
+                int64_t count,
+                MPI_Datatype type,
+                int dest,
+                int tag,
+                MPI_Comm comm,
+                std::vector<MPI_Request>& requests)
+{
+#if MPI_VERSION >= 4
+  requests.emplace_back();
+  CHECK_MPI(MPI_Isend_c(buf, count, type, dest, tag, comm, &requests.back()));
+#else
+  MPI_Aint lb, type_extent;
+  MPI_Type_get_extent(type, &lb, &type_extent);
+  const char* ptr = static_cast<const char*>(buf);
+  do {
+    int chunk = static_cast<int>(std::min(count, MAX_MESSAGE_COUNT));
+    requests.emplace_back();
+    CHECK_MPI(MPI_Isend(ptr, chunk, type, dest, tag, comm, &requests.back()));
+    ptr += static_cast<ptrdiff_t>(chunk) * type_extent;
+    count -= chunk;
+  } while (count > 0);
+#endif
+}
+
+void irecvLarge(void* buf,
+                int64_t count,
+                MPI_Datatype type,
+                int source,
+                int tag,
+                MPI_Comm comm,
+                std::vector<MPI_Request>& requests)
+{
+#if MPI_VERSION >= 4
+  requests.emplace_back();
+  CHECK_MPI(MPI_Irecv_c(buf, count, type, source, tag, comm, &requests.back()));
+#else
+  MPI_Aint lb, type_extent;
+  MPI_Type_get_extent(type, &lb, &type_extent);
+  char* ptr = static_cast<char*>(buf);
+  do {
+    int chunk = static_cast<int>(std::min(count, MAX_MESSAGE_COUNT));
+    requests.emplace_back();
+    CHECK_MPI(MPI_Irecv(ptr, chunk, type, source, tag, comm, &requests.back()));
+    ptr += static_cast<ptrdiff_t>(chunk) * type_extent;
+    count -= chunk;
+  } while (count > 0);
+#endif
+}
+
+void sendLarge(const void* buf, int64_t count, MPI_Datatype type, int dest, int tag, MPI_Comm comm)
+{
+  if (count <= MAX_MESSAGE_COUNT) {
+    CHECK_MPI_WAIT(MPI_Send(buf, static_cast<int>(count), type, dest, tag, comm));
+    return;
+  }
+  std::vector<MPI_Request> requests;
+  isendLarge(buf, count, type, dest, tag, comm, requests);
+  CHECK_MPI_WAIT(MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE));
+}
+
+void recvLarge(void* buf, int64_t count, MPI_Datatype type, int source, int tag, MPI_Comm comm)
+{
+  if (count <= MAX_MESSAGE_COUNT) {
+    CHECK_MPI_WAIT(
+      MPI_Recv(buf, static_cast<int>(count), type, source, tag, comm, MPI_STATUS_IGNORE));
+    return;
+  }
+  std::vector<MPI_Request> requests;
+  irecvLarge(buf, count, type, source, tag, comm, requests);
+  CHECK_MPI_WAIT(MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE));
+}
+
+void sendrecvLarge(const void* sendbuf,
+                   int64_t sendcount,
+                   int dest,
+                   int sendtag,
+                   void* recvbuf,
+                   int64_t recvcount,
+                   int source,
+                   int recvtag,
+                   MPI_Datatype type,
+                   MPI_Comm comm)
+{
+  if (sendcount <= MAX_MESSAGE_COUNT && recvcount <= MAX_MESSAGE_COUNT) {
+    CHECK_MPI_WAIT(MPI_Sendrecv(sendbuf,
+                                static_cast<int>(sendcount),
+                                type,
+                                dest,
+                                sendtag,
+                                recvbuf,
+                                static_cast<int>(recvcount),
+                                type,
+                                source,
+                                recvtag,
+                                comm,
+                                MPI_STATUS_IGNORE));
+    return;
+  }
+  std::vector<MPI_Request> requests;
+  irecvLarge(recvbuf, recvcount, type, source, recvtag, comm, requests);
+  isendLarge(sendbuf, sendcount, type, dest, sendtag, comm, requests);
+  CHECK_MPI_WAIT(MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE));
+}
+
 int generateAlltoallTag(int rank1, int rank2, CollComm global_comm)
 {
   int tag = match2ranks(rank1, rank2, global_comm) * CollTag::MAX_TAG + CollTag::ALLTOALL_TAG;
@@ -437,20 +1222,82 @@ int generateAlltoallvTag(int rank1, int rank2, CollComm global_comm)
   return tag;
 }
 
-int generateBcastTag(int rank, CollComm global_comm)
+int generateBcastTag(int rank1, int rank2, CollComm global_comm)
 {
-  int tag = rank * CollTag::MAX_TAG + CollTag::BCAST_TAG;
+  int tag = match2ranks(rank1, rank2, global_comm) * CollTag::MAX_TAG + CollTag::BCAST_TAG;
   assert(tag <= mpi_tag_ub && tag >= 0);
   return tag;
 }
 
-int generateGatherTag(int rank, CollComm global_comm)
+int generateBcastRingTag(int rank1, int rank2, CollComm global_comm)
+{
+  int tag = match2ranks(rank1, rank2, global_comm) * CollTag::MAX_TAG + CollTag::BCAST_RING_TAG;
+  assert(tag <= mpi_tag_ub && tag > 0);
+  return tag;
+}
+
+int generateGatherTag(int rank1, int rank2, CollComm global_comm)
+{
+  int tag = match2ranks(rank1, rank2, global_comm) * CollTag::MAX_TAG + CollTag::GATHER_TAG;
+  assert(tag <= mpi_tag_ub && tag > 0);
+  return tag;
+}
+
+int generateAllgathervTag(int rank1, int rank2, CollComm global_comm)
+{
+  int tag = match2ranks(rank1, rank2, global_comm) * CollTag::MAX_TAG + CollTag::ALLGATHERV_TAG;
+  assert(tag <= mpi_tag_ub && tag > 0);
+  return tag;
+}
+
+int generateAllreduceTag(int rank1, int rank2, CollComm global_comm)
+{
+  int tag = match2ranks(rank1, rank2, global_comm) * CollTag::MAX_TAG + CollTag::ALLREDUCE_TAG;
+  assert(tag <= mpi_tag_ub && tag > 0);
+  return tag;
+}
+
+int generateReduceTag(int rank1, int rank2, CollComm global_comm)
+{
+  int tag = match2ranks(rank1, rank2, global_comm) * CollTag::MAX_TAG + CollTag::REDUCE_TAG;
+  assert(tag <= mpi_tag_ub && tag > 0);
+  return tag;
+}
+
+int generateReduceScatterTag(int rank1, int rank2, CollComm global_comm)
+{
+  int tag =
+    match2ranks(rank1, rank2, global_comm) * CollTag::MAX_TAG + CollTag::REDUCE_SCATTER_TAG;
+  assert(tag <= mpi_tag_ub && tag > 0);
+  return tag;
+}
+
+int generateIalltoallvTag(int rank1, int rank2, CollComm global_comm)
+{
+  int tag = match2ranks(rank1, rank2, global_comm) * CollTag::MAX_TAG + CollTag::IALLTOALLV_TAG;
+  assert(tag <= mpi_tag_ub && tag > 0);
+  return tag;
+}
+
+int generateIallgatherTag(int rank1, int rank2, CollComm global_comm)
+{
+  int tag = match2ranks(rank1, rank2, global_comm) * CollTag::MAX_TAG + CollTag::IALLGATHER_TAG;
+  assert(tag <= mpi_tag_ub && tag > 0);
+  return tag;
+}
+
+int generateIallreduceTag(int rank1, int rank2, CollComm global_comm)
 {
-  int tag = rank * CollTag::MAX_TAG + CollTag::GATHER_TAG;
+  int tag = match2ranks(rank1, rank2, global_comm) * CollTag::MAX_TAG + CollTag::IALLREDUCE_TAG;
   assert(tag <= mpi_tag_ub && tag > 0);
   return tag;
 }
 
+int64_t generateMaxTag(int nb_threads)
+{
+  return static_cast<int64_t>(nb_threads) * nb_threads * CollTag::MAX_TAG - 1;
+}
+
 #else  // undef LEGATE_USE_NETWORK
 size_t getDtypeSize(CollDataType dtype)
 {
@@ -480,27 +1327,383 @@ size_t getDtypeSize(CollDataType dtype)
     case CollDataType::CollDouble: {
       return sizeof(double);
     }
+    case CollDataType::CollBool: {
+      return sizeof(bool);
+    }
+    case CollDataType::CollInt16: {
+      return sizeof(int16_t);
+    }
+    case CollDataType::CollUint16:
+    case CollDataType::CollHalf: {
+      return sizeof(uint16_t);
+    }
+    case CollDataType::CollComplex64: {
+      return sizeof(complex<float>);
+    }
+    case CollDataType::CollComplex128: {
+      return sizeof(complex<double>);
+    }
     default: {
-      log_coll.fatal("Unknown datatype");
-      LEGATE_ABORT;
-      return 0;
+      return getUserType(dtype).size;
     }
   }
 }
 
-void resetLocalBuffer(CollComm global_comm)
+#endif
+
+// Wrap-around safe check that a slot counter has reached the target sequence number
+static inline bool reachedSeq(uint32_t counter, uint32_t target)
+{
+  return static_cast<int32_t>(counter - target) >= 0;
+}
+
+static inline void cpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield" ::: "memory");
+#endif
+}
+
+static inline void waitOnCounter(std::atomic<uint32_t>* counter, uint32_t value)
 {
-  int global_rank                         = global_comm->global_rank;
-  global_comm->comm->buffers[global_rank] = nullptr;
-  global_comm->comm->displs[global_rank]  = nullptr;
+#ifdef __linux__
+  syscall(SYS_futex,
+          reinterpret_cast<uint32_t*>(counter),
+          FUTEX_WAIT_PRIVATE,
+          value,
+          nullptr,
+          nullptr,
+          0);
+#else
+  std::this_thread::yield();
+#endif
+}
+
+static inline void wakeOnCounter(std::atomic<uint32_t>* counter)
+{
+#ifdef __linux__
+  syscall(SYS_futex,
+          reinterpret_cast<uint32_t*>(counter),
+          FUTEX_WAKE_PRIVATE,
+          INT_MAX,
+          nullptr,
+          nullptr,
+          0);
+#endif
+}
+
+static inline const UserType& getUserType(CollDataType dtype)
+{
+  int idx = static_cast<int>(dtype) - static_cast<int>(CollDataType::CollUserType);
+  if (idx < 0 || idx >= nb_user_types.load(std::memory_order_acquire)) {
+    log_coll.fatal("Unknown datatype");
+    LEGATE_ABORT;
+  }
+  return user_types[idx];
+}
+
+static inline ThreadComm* getLocalComm(CollComm global_comm)
+{
+#ifdef LEGATE_USE_NETWORK
+  return global_comm->local_comm;
+#else
+  return global_comm->comm;
+#endif
+}
+
+static inline int getLocalRank(CollComm global_comm)
+{
+#ifdef LEGATE_USE_NETWORK
+  return global_comm->local_rank;
+#else
+  return global_comm->global_rank;
+#endif
+}
+
+static inline int getLocalCommSize(CollComm global_comm)
+{
+#ifdef LEGATE_USE_NETWORK
+  return global_comm->local_comm_size;
+#else
+  return global_comm->global_comm_size;
+#endif
+}
+
+static inline int getGlobalRankOfLocal(CollComm global_comm, int local_rank)
+{
+#ifdef LEGATE_USE_NETWORK
+  return global_comm->local_ranks[local_rank];
+#else
+  return local_rank;
+#endif
+}
+
+#ifdef LEGATE_USE_NETWORK
+static void setupComm(CollComm global_comm,
+                      MPI_Comm comm,
+                      const int* mapping_table,
+                      ThreadComm* thread_comm)
+{
+  int mpi_rank, mpi_comm_size;
+  int global_comm_size = global_comm->global_comm_size;
+  int global_rank      = global_comm->global_rank;
+  CHECK_MPI(MPI_Comm_rank(comm, &mpi_rank));
+  CHECK_MPI(MPI_Comm_size(comm, &mpi_comm_size));
+  global_comm->mpi_comm_size = mpi_comm_size;
+  global_comm->mpi_rank      = mpi_rank;
+  global_comm->comm          = comm;
+  assert(mapping_table != nullptr);
+  global_comm->mapping_table.global_rank = (int*)malloc(sizeof(int) * global_comm_size);
+  global_comm->mapping_table.mpi_rank    = (int*)malloc(sizeof(int) * global_comm_size);
+  memcpy(global_comm->mapping_table.mpi_rank, mapping_table, sizeof(int) * global_comm_size);
+  for (int i = 0; i < global_comm_size; i++) { global_comm->mapping_table.global_rank[i] = i; }
+  std::pair<int, int> p             = mostFrequent(mapping_table, global_comm_size);
+  global_comm->nb_threads           = p.first;
+  global_comm->mpi_comm_size_actual = p.second;
+
+  global_comm->mapping_table.local_index = (int*)malloc(sizeof(int) * global_comm_size);
+  std::vector<int> nb_ranks_of_process(mpi_comm_size, 0);
+  for (int i = 0; i < global_comm_size; i++) {
+    global_comm->mapping_table.local_index[i] = nb_ranks_of_process[mapping_table[i]]++;
+  }
+  int64_t max_tag = generateMaxTag(global_comm->nb_threads);
+  if (max_tag > mpi_tag_ub) {
+    log_coll.fatal(
+      "Communicator with %d ranks per process needs MPI tags up to %lld, but MPI_TAG_UB is %d",
+      global_comm->nb_threads,
+      static_cast<long long>(max_tag),
+      mpi_tag_ub);
+    LEGATE_ABORT;
+  }
+
+  global_comm->local_ranks     = (int*)malloc(sizeof(int) * global_comm_size);
+  global_comm->local_comm_size = 0;
+  for (int i = 0; i < global_comm_size; i++) {
+    if (mapping_table[i] != mpi_rank) { continue; }
+    if (i == global_rank) { global_comm->local_rank = global_comm->local_comm_size; }
+    global_comm->local_ranks[global_comm->local_comm_size++] = i;
+  }
+  attachStats(global_comm);
+  attachLocalComm(global_comm, thread_comm);
+}
+#else
+static void setupComm(CollComm global_comm, ThreadComm* thread_comm)
+{
+  global_comm->mpi_comm_size        = 1;
+  global_comm->mpi_comm_size_actual = 1;
+  global_comm->mpi_rank             = 0;
+  attachStats(global_comm);
+  attachLocalComm(global_comm, thread_comm);
+  global_comm->nb_threads = global_comm->global_comm_size;
+}
+#endif
+
+static ThreadComm* createThreadComm()
+{
+  ThreadComm* thread_comm  = new ThreadComm;
+  thread_comm->ready_flag  = false;
+  thread_comm->nb_detached = 0;
+  thread_comm->slots       = nullptr;
+  return thread_comm;
+}
+
+// Called by every local rank of a derived communicator once it is detached. The detach leaves
+// nb_detached at the number of local ranks minus one, so the last rank to get here, which no
+// longer races with anyone polling the ready flag, frees the state.
+static void releaseThreadComm(ThreadComm* thread_comm)
+{
+  if (thread_comm->nb_detached.fetch_sub(1, std::memory_order_acq_rel) == 0) {
+    delete thread_comm;
+  }
+}
+
+// The first local rank sets up the slots that all local ranks of the communicator share
+static void attachLocalComm(CollComm global_comm, ThreadComm* thread_comm)
+{
+  int local_comm_size = getLocalCommSize(global_comm);
+  if (getLocalRank(global_comm) == 0) {
+    thread_comm->slots = new ThreadCommSlot[local_comm_size];
+    for (int i = 0; i < local_comm_size; i++) {
+      thread_comm->slots[i].counter = 0;
+      thread_comm->slots[i].waiters = 0;
+      thread_comm->slots[i].buffer  = nullptr;
+      thread_comm->slots[i].displs  = nullptr;
+    }
+    thread_comm->nb_detached = 0;
+    thread_comm->ready_flag.store(true, std::memory_order_release);
+  }
+  while (!thread_comm->ready_flag.load(std::memory_order_acquire)) { std::this_thread::yield(); }
+#ifdef LEGATE_USE_NETWORK
+  global_comm->local_comm = thread_comm;
+#else
+  global_comm->comm = thread_comm;
+#endif
+  global_comm->local_seq = 0;
+  barrierLocal(global_comm);
+  assert(thread_comm->slots != nullptr);
+}
+
+static void detachLocalComm(CollComm global_comm)
+{
+  barrierLocal(global_comm);
+  ThreadComm* thread_comm = getLocalComm(global_comm);
+  if (getLocalRank(global_comm) == 0) {
+    // Other ranks may still be polling the slots on their way out of the barrier
+    while (thread_comm->nb_detached.load(std::memory_order_acquire) !=
+           getLocalCommSize(global_comm) - 1) {
+      std::this_thread::yield();
+    }
+    delete[] thread_comm->slots;
+    thread_comm->slots = nullptr;
+    thread_comm->ready_flag.store(false, std::memory_order_release);
+  } else {
+    thread_comm->nb_detached.fetch_add(1, std::memory_order_acq_rel);
+    while (thread_comm->ready_flag.load(std::memory_order_acquire)) { std::this_thread::yield(); }
+  }
+}
+
+static void attachStats(CollComm global_comm)
+{
+  global_comm->stats = nullptr;
+  if (!stats_enabled) { return; }
+  global_comm->stats = new CollStats();
+  std::lock_guard<std::mutex> guard(stats_lock);
+  live_stats.push_back(global_comm->stats);
+}
+
+static void retireStats(CollComm global_comm)
+{
+  CollStats* stats = global_comm->stats;
+  if (stats == nullptr) { return; }
+  global_comm->stats = nullptr;
+  for (int kind = 0; kind < LEGATE_CPUCOLL_NUM_KINDS; kind++) {
+    legate_cpucoll_stats_t rank_stats;
+    memset(&rank_stats, 0, sizeof(rank_stats));
+    accumulateStats(&rank_stats, stats->kinds[kind]);
+    if (rank_stats.calls == 0) { continue; }
+    log_coll.info(
+      "%s on comm id %d, global_rank %d: %llu calls, %llu bytes sent, %llu bytes received, "
+      "%.6f s, %.6f s waiting, max skew %.6f s",
+      COLL_KIND_NAMES[kind],
+      global_comm->unique_id,
+      global_comm->global_rank,
+      static_cast<unsigned long long>(rank_stats.calls),
+      static_cast<unsigned long long>(rank_stats.bytes_sent),
+      static_cast<unsigned long long>(rank_stats.bytes_received),
+      rank_stats.time,
+      rank_stats.wait_time,
+      rank_stats.max_skew);
+  }
+  std::lock_guard<std::mutex> guard(stats_lock);
+  for (int kind = 0; kind < LEGATE_CPUCOLL_NUM_KINDS; kind++) {
+    accumulateStats(&retired_stats[kind], stats->kinds[kind]);
+  }
+  live_stats.erase(std::find(live_stats.begin(), live_stats.end(), stats));
+  delete stats;
+}
+
+static void accumulateStats(legate_cpucoll_stats_t* total, const CollKindStats& stats)
+{
+  total->calls += stats.calls.load(std::memory_order_relaxed);
+  total->bytes_sent += stats.bytes_sent.load(std::memory_order_relaxed);
+  total->bytes_received += stats.bytes_received.load(std::memory_order_relaxed);
+  total->time += stats.time_ns.load(std::memory_order_relaxed) * 1e-9;
+  total->wait_time += stats.wait_ns.load(std::memory_order_relaxed) * 1e-9;
+  total->max_skew =
+    std::max(total->max_skew, stats.max_skew_ns.load(std::memory_order_relaxed) * 1e-9);
+}
+
+static inline uint64_t nowNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+#ifdef LEGATE_USE_NETWORK
+CollWaitScope::CollWaitScope()
+{
+  if (timing_waits) { start_ns_ = nowNs(); }
+}
+
+CollWaitScope::~CollWaitScope()
+{
+  if (start_ns_ != 0) { local_wait_ns += nowNs() - start_ns_; }
+}
+#endif
+
+static inline int64_t* getCountScratch(size_t size)
+{
+  if (count_scratch.size() < size) { count_scratch.resize(size); }
+  return count_scratch.data();
+}
+
+void publishLocalBuffer(CollComm global_comm, const void* buffer, const int64_t* displs)
+{
+  ThreadCommSlot& slot = getLocalComm(global_comm)->slots[getLocalRank(global_comm)];
+  slot.buffer          = buffer;
+  slot.displs          = displs;
+  signalLocal(global_comm);
+}
+
+void signalLocal(CollComm global_comm)
+{
+  ThreadCommSlot& slot = getLocalComm(global_comm)->slots[getLocalRank(global_comm)];
+  slot.counter.store(++global_comm->local_seq, std::memory_order_seq_cst);
+  // Pairs with the increment of waiters in waitLocal, so either the waiter observes the new
+  // counter value before sleeping or we observe the waiter and wake it up
+  if (slot.waiters.load(std::memory_order_seq_cst) > 0) { wakeOnCounter(&slot.counter); }
+}
+
+static void waitSlot(ThreadCommSlot& slot, uint32_t target)
+{
+  for (int spin = 0; spin < LOCAL_SPIN_COUNT; spin++) {
+    if (reachedSeq(slot.counter.load(std::memory_order_acquire), target)) { return; }
+    cpuRelax();
+  }
+  // The peer is not making progress, most likely because it shares our core, so get out of
+  // its way until it publishes
+  slot.waiters.fetch_add(1, std::memory_order_seq_cst);
+  while (true) {
+    uint32_t counter = slot.counter.load(std::memory_order_seq_cst);
+    if (reachedSeq(counter, target)) { break; }
+    waitOnCounter(&slot.counter, counter);
+  }
+  slot.waiters.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void waitLocal(CollComm global_comm, int local_rank)
+{
+  ThreadCommSlot& slot = getLocalComm(global_comm)->slots[local_rank];
+  uint32_t target      = global_comm->local_seq;
+  if (reachedSeq(slot.counter.load(std::memory_order_acquire), target)) { return; }
+  // Only time the waits that actually block, to keep the fast path free of clock reads
+  if (global_comm->stats == nullptr) {
+    waitSlot(slot, target);
+    return;
+  }
+  uint64_t start = nowNs();
+  waitSlot(slot, target);
+  local_wait_ns += nowNs() - start;
+}
+
+bool pollLocal(CollComm global_comm, int local_rank)
+{
+  ThreadCommSlot& slot = getLocalComm(global_comm)->slots[local_rank];
+  return reachedSeq(slot.counter.load(std::memory_order_acquire), global_comm->local_seq);
 }
 
 void barrierLocal(CollComm global_comm)
 {
   assert(coll_inited == true);
-  pthread_barrier_wait(const_cast<pthread_barrier_t*>(&(global_comm->comm->barrier)));
+  signalLocal(global_comm);
+  int local_rank = getLocalRank(global_comm);
+  for (int i = 0; i < getLocalCommSize(global_comm); i++) {
+    if (i != local_rank) { waitLocal(global_comm, i); }
+  }
 }
-#endif
 
 void* allocateInplaceBuffer(const void* recvbuf, size_t size)
 {
@@ -510,6 +1713,184 @@ void* allocateInplaceBuffer(const void* recvbuf, size_t size)
   return sendbuf_tmp;
 }
 
+template <typename T>
+static inline void applyReductionTyped(T* inout, const T* in, size_t count, CollReductionOp op)
+{
+  switch (op) {
+    case CollReductionOp::CollSum: {
+      for (size_t i = 0; i < count; i++) inout[i] = static_cast<T>(inout[i] + in[i]);
+      break;
+    }
+    case CollReductionOp::CollProd: {
+      for (size_t i = 0; i < count; i++) inout[i] = static_cast<T>(inout[i] * in[i]);
+      break;
+    }
+    case CollReductionOp::CollMin: {
+      for (size_t i = 0; i < count; i++) inout[i] = std::min(inout[i], in[i]);
+      break;
+    }
+    case CollReductionOp::CollMax: {
+      for (size_t i = 0; i < count; i++) inout[i] = std::max(inout[i], in[i]);
+      break;
+    }
+    default: {
+      log_coll.fatal("Unknown reduction op");
+      LEGATE_ABORT;
+    }
+  }
+}
+
+// Booleans reduce with logical operators, the sum and max being an or, and the product and min an
+// and, as in the Legion reduction operators
+static inline void applyReductionBool(bool* inout,
+                                      const bool* in,
+                                      size_t count,
+                                      CollReductionOp op)
+{
+  switch (op) {
+    case CollReductionOp::CollSum:
+    case CollReductionOp::CollMax: {
+      for (size_t i = 0; i < count; i++) inout[i] = inout[i] || in[i];
+      break;
+    }
+    case CollReductionOp::CollProd:
+    case CollReductionOp::CollMin: {
+      for (size_t i = 0; i < count; i++) inout[i] = inout[i] && in[i];
+      break;
+    }
+    default: {
+      log_coll.fatal("Unknown reduction op");
+      LEGATE_ABORT;
+    }
+  }
+}
+
+// Half-precision values are combined in single precision and rounded back
+static inline void applyReductionHalf(__half* inout,
+                                      const __half* in,
+                                      size_t count,
+                                      CollReductionOp op)
+{
+  for (size_t i = 0; i < count; i++) {
+    float lhs = static_cast<float>(inout[i]);
+    float rhs = static_cast<float>(in[i]);
+    switch (op) {
+      case CollReductionOp::CollSum: lhs = lhs + rhs; break;
+      case CollReductionOp::CollProd: lhs = lhs * rhs; break;
+      case CollReductionOp::CollMin: lhs = std::min(lhs, rhs); break;
+      case CollReductionOp::CollMax: lhs = std::max(lhs, rhs); break;
+      default: {
+        log_coll.fatal("Unknown reduction op");
+        LEGATE_ABORT;
+      }
+    }
+    inout[i] = static_cast<__half>(lhs);
+  }
+}
+
+// Complex numbers have no ordering, so only the sum and the product are defined
+template <typename T>
+static inline void applyReductionComplex(T* inout, const T* in, size_t count, CollReductionOp op)
+{
+  switch (op) {
+    case CollReductionOp::CollSum: {
+      for (size_t i = 0; i < count; i++) inout[i] = inout[i] + in[i];
+      break;
+    }
+    case CollReductionOp::CollProd: {
+      for (size_t i = 0; i < count; i++) inout[i] = inout[i] * in[i];
+      break;
+    }
+    default: {
+      log_coll.fatal("Complex values only support sum and product reductions");
+      LEGATE_ABORT;
+    }
+  }
+}
+
+void applyReduction(
+  void* inout, const void* in, size_t count, CollDataType type, CollReductionOp op)
+{
+  switch (type) {
+    case CollDataType::CollInt8: {
+      applyReductionTyped(static_cast<int8_t*>(inout), static_cast<const int8_t*>(in), count, op);
+      break;
+    }
+    case CollDataType::CollChar: {
+      applyReductionTyped(static_cast<char*>(inout), static_cast<const char*>(in), count, op);
+      break;
+    }
+    case CollDataType::CollUint8: {
+      applyReductionTyped(
+        static_cast<uint8_t*>(inout), static_cast<const uint8_t*>(in), count, op);
+      break;
+    }
+    case CollDataType::CollInt: {
+      applyReductionTyped(static_cast<int*>(inout), static_cast<const int*>(in), count, op);
+      break;
+    }
+    case CollDataType::CollUint32: {
+      applyReductionTyped(
+        static_cast<uint32_t*>(inout), static_cast<const uint32_t*>(in), count, op);
+      break;
+    }
+    case CollDataType::CollInt64: {
+      applyReductionTyped(
+        static_cast<int64_t*>(inout), static_cast<const int64_t*>(in), count, op);
+      break;
+    }
+    case CollDataType::CollUint64: {
+      applyReductionTyped(
+        static_cast<uint64_t*>(inout), static_cast<const uint64_t*>(in), count, op);
+      break;
+    }
+    case CollDataType::CollFloat: {
+      applyReductionTyped(static_cast<float*>(inout), static_cast<const float*>(in), count, op);
+      break;
+    }
+    case CollDataType::CollDouble: {
+      applyReductionTyped(static_cast<double*>(inout), static_cast<const double*>(in), count, op);
+      break;
+    }
+    case CollDataType::CollBool: {
+      applyReductionBool(static_cast<bool*>(inout), static_cast<const bool*>(in), count, op);
+      break;
+    }
+    case CollDataType::CollInt16: {
+      applyReductionTyped(
+        static_cast<int16_t*>(inout), static_cast<const int16_t*>(in), count, op);
+      break;
+    }
+    case CollDataType::CollUint16: {
+      applyReductionTyped(
+        static_cast<uint16_t*>(inout), static_cast<const uint16_t*>(in), count, op);
+      break;
+    }
+    case CollDataType::CollHalf: {
+      applyReductionHalf(static_cast<__half*>(inout), static_cast<const __half*>(in), count, op);
+      break;
+    }
+    case CollDataType::CollComplex64: {
+      applyReductionComplex(
+        static_cast<complex<float>*>(inout), static_cast<const complex<float>*>(in), count, op);
+      break;
+    }
+    case CollDataType::CollComplex128: {
+      applyReductionComplex(
+        static_cast<complex<double>*>(inout), static_cast<const complex<double>*>(in), count, op);
+      break;
+    }
+    default: {
+      if (static_cast<int>(type) >= static_cast<int>(CollDataType::CollUserType)) {
+        log_coll.fatal("Reductions are not supported on registered types");
+      } else {
+        log_coll.fatal("Unknown datatype");
+      }
+      LEGATE_ABORT;
+    }
+  }
+}
+
 }  // namespace coll
 }  // namespace comm
 }  // namespace legate
@@ -519,4 +1900,9 @@ extern "C" {
 void legate_cpucoll_finalize(void) { legate::comm::coll::collFinalize(); }
 
 int legate_cpucoll_initcomm(void) { return legate::comm::coll::collInitComm(); }
+
+int legate_cpucoll_get_stats(legate_cpucoll_kind_t kind, legate_cpucoll_stats_t* stats)
+{
+  return legate::comm::coll::collGetStats(kind, stats);
+}
 }
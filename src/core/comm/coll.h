@@ -18,22 +18,16 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <atomic>
 #include <vector>
 
 #ifdef LEGATE_USE_NETWORK
 #include <mpi.h>
-#else
-// If we aren't building with networking, we'll use pthread_barrier to
-// construct a communicator for thread-local communication. Mac OS
-// does not implement pthread barriers, so we need to include an
-// implementation in case they are not defined. We also need to
-// include unistd.h since that defines _POSIX_BARRIERS.
-#include <unistd.h>
-#if !defined(_POSIX_BARRIERS) || (_POSIX_BARRIERS < 0)
-#include "core/comm/pthread_barrier.h"
-#endif
 #endif
 
+#include "core/legate_c.h"
+
 namespace legate {
 namespace comm {
 namespace coll {
@@ -46,31 +40,77 @@ namespace coll {
     check_mpi(result, __FILE__, __LINE__); \
   } while (false)
 
+// Accounts the time from construction to destruction as time the calling rank spent blocked on
+// its peers, when it is inside a collective whose communicator collects statistics
+class CollWaitScope {
+ public:
+  CollWaitScope();
+  ~CollWaitScope();
+  CollWaitScope(const CollWaitScope&)            = delete;
+  CollWaitScope& operator=(const CollWaitScope&) = delete;
+
+ private:
+  uint64_t start_ns_{0};
+};
+
+// CHECK_MPI for the blocking calls, whose time counts towards the wait time of the collective
+#define CHECK_MPI_WAIT(expr)    \
+  do {                          \
+    CollWaitScope wait_scope{}; \
+    CHECK_MPI(expr);            \
+  } while (false)
+
 struct RankMappingTable {
   int* mpi_rank;
   int* global_rank;
+  // Position of each rank among the ranks of its process, which is what tags are built from
+  int* local_index;
 };
 
-#else
+#endif
+
+// Each rank of a process-local group owns one cache-line sized slot so that publishing a
+// buffer never invalidates the line another rank is polling. The counter is advanced once per
+// synchronization step of a collective; a peer's buffer is valid once its counter has caught
+// up with ours.
+struct alignas(64) ThreadCommSlot {
+  std::atomic<uint32_t> counter;
+  std::atomic<uint32_t> waiters;
+  const void* buffer;
+  const int64_t* displs;
+};
 
 struct ThreadComm {
-  pthread_barrier_t barrier;
-  bool ready_flag;
-  const void** buffers;
-  const int** displs;
+  std::atomic<bool> ready_flag;
+  std::atomic<int> nb_detached;
+  ThreadCommSlot* slots;
 };
-#endif
 
 enum class CollDataType : int {
-  CollInt8   = 0,
-  CollChar   = 1,
-  CollUint8  = 2,
-  CollInt    = 3,
-  CollUint32 = 4,
-  CollInt64  = 5,
-  CollUint64 = 6,
-  CollFloat  = 7,
-  CollDouble = 8,
+  CollInt8       = 0,
+  CollChar       = 1,
+  CollUint8      = 2,
+  CollInt        = 3,
+  CollUint32     = 4,
+  CollInt64      = 5,
+  CollUint64     = 6,
+  CollFloat      = 7,
+  CollDouble     = 8,
+  CollBool       = 9,
+  CollInt16      = 10,
+  CollUint16     = 11,
+  CollHalf       = 12,
+  CollComplex64  = 13,
+  CollComplex128 = 14,
+  // Types registered with collTypeRegister are numbered from here on
+  CollUserType = 64,
+};
+
+enum class CollReductionOp : int {
+  CollSum  = 0,
+  CollProd = 1,
+  CollMin  = 2,
+  CollMax  = 3,
 };
 
 enum CollStatus : int {
@@ -78,13 +118,37 @@ enum CollStatus : int {
   CollError   = 1,
 };
 
+// Telemetry of the collectives of one kind issued by a rank, collected when LEGATE_COLL_STATS is
+// set. Only the rank itself updates its counters, but they can be read at any time.
+struct CollKindStats {
+  std::atomic<uint64_t> calls;
+  std::atomic<uint64_t> bytes_sent;
+  std::atomic<uint64_t> bytes_received;
+  std::atomic<uint64_t> time_ns;
+  std::atomic<uint64_t> wait_ns;
+  std::atomic<uint64_t> max_skew_ns;
+};
+
+struct CollStats {
+  CollKindStats kinds[LEGATE_CPUCOLL_NUM_KINDS];
+};
+
+// Color of the ranks that take no part in the communicator derived by collCommSplit
+constexpr int CollUndefined = -1;
+
 struct Coll_Comm {
 #ifdef LEGATE_USE_NETWORK
   MPI_Comm comm;
   RankMappingTable mapping_table;
+  // The ranks that live in this process, which exchange data through shared memory
+  ThreadComm* local_comm;
+  int* local_ranks;
+  int local_rank;
+  int local_comm_size;
 #else
-  volatile ThreadComm* comm;
+  ThreadComm* comm;
 #endif
+  uint32_t local_seq;
   int mpi_rank;
   int mpi_comm_size;
   int mpi_comm_size_actual;
@@ -93,10 +157,21 @@ struct Coll_Comm {
   int nb_threads;
   int unique_id;
   bool status;
+  // Set for communicators derived by collCommSplit, which own their MPI communicator and
+  // shared-memory state instead of borrowing them from collInitComm
+  bool derived;
+  // Null unless telemetry is enabled
+  CollStats* stats;
 };
 
 typedef Coll_Comm* CollComm;
 
+// Handle to an outstanding nonblocking collective. It is released, and set to nullptr, by the
+// collTest call that observes its completion or by collWait.
+struct Coll_Request;
+
+typedef Coll_Request* CollRequest;
+
 int collCommCreate(CollComm global_comm,
                    int global_comm_size,
                    int global_rank,
@@ -105,6 +180,15 @@ int collCommCreate(CollComm global_comm,
 
 int collCommDestroy(CollComm global_comm);
 
+// Collective over all ranks of global_comm. Ranks passing the same color end up in the same
+// communicator, ordered by key and then by their rank in global_comm; ranks passing
+// CollUndefined get an inactive communicator. The result is destroyed with collCommDestroy.
+int collCommSplit(CollComm global_comm, int color, int key, CollComm new_comm);
+
+// Alltoallv and Alltoall can run in place, with sendbuf == recvbuf. As with MPI_IN_PLACE, the
+// block exchanged with rank i is then described by recvcounts[i] and rdispls[i] in both
+// directions, which requires recvcounts[i] on this rank to match recvcounts[j] on rank i for
+// this rank j. The exchange needs no copy of the buffer.
 int collAlltoallv(const void* sendbuf,
                   const int sendcounts[],
                   const int sdispls[],
@@ -120,70 +204,394 @@ int collAlltoall(
 int collAllgather(
   const void* sendbuf, void* recvbuf, int count, CollDataType type, CollComm global_comm);
 
+// Every rank contributes sendcount elements, which must match recvcounts[rank], and receives the
+// contribution of rank i at offset displs[i] of recvbuf. recvcounts and displs must be the same
+// on all ranks. When sendbuf is recvbuf, the contribution of the rank is taken from its block of
+// recvbuf.
+int collAllgatherv(const void* sendbuf,
+                   int sendcount,
+                   void* recvbuf,
+                   const int recvcounts[],
+                   const int displs[],
+                   CollDataType type,
+                   CollComm global_comm);
+
+// Variants of the collectives above whose counts and displacements are not limited to 2^31
+// elements. The int versions forward to these.
+int collAlltoallvLarge(const void* sendbuf,
+                       const int64_t sendcounts[],
+                       const int64_t sdispls[],
+                       void* recvbuf,
+                       const int64_t recvcounts[],
+                       const int64_t rdispls[],
+                       CollDataType type,
+                       CollComm global_comm);
+
+int collAlltoallLarge(
+  const void* sendbuf, void* recvbuf, int64_t count, CollDataType type, CollComm global_comm);
+
+int collAllgatherLarge(
+  const void* sendbuf, void* recvbuf, int64_t count, CollDataType type, CollComm global_comm);
+
+int collAllgathervLarge(const void* sendbuf,
+                        int64_t sendcount,
+                        void* recvbuf,
+                        const int64_t recvcounts[],
+                        const int64_t displs[],
+                        CollDataType type,
+                        CollComm global_comm);
+
+int collBcast(void* buf, int count, CollDataType type, int root, CollComm global_comm);
+
+// Only the root's recvbuf is written, with the count elements of rank i at offset i * count
+int collGather(const void* sendbuf,
+               void* recvbuf,
+               int count,
+               CollDataType type,
+               int root,
+               CollComm global_comm);
+
+int collAllreduce(const void* sendbuf,
+                  void* recvbuf,
+                  int count,
+                  CollDataType type,
+                  CollReductionOp op,
+                  CollComm global_comm);
+
+int collReduce(const void* sendbuf,
+               void* recvbuf,
+               int count,
+               CollDataType type,
+               CollReductionOp op,
+               int root,
+               CollComm global_comm);
+
+int collReduceScatter(const void* sendbuf,
+                      void* recvbuf,
+                      int recvcount,
+                      CollDataType type,
+                      CollReductionOp op,
+                      CollComm global_comm);
+
+// Nonblocking collectives. The buffers must stay untouched until the request completes. At most
+// one nonblocking collective can be in flight on a communicator, and no other collective may be
+// issued on that communicator before it completes.
+int collIalltoallv(const void* sendbuf,
+                   const int sendcounts[],
+                   const int sdispls[],
+                   void* recvbuf,
+                   const int recvcounts[],
+                   const int rdispls[],
+                   CollDataType type,
+                   CollComm global_comm,
+                   CollRequest* request);
+
+int collIallgather(const void* sendbuf,
+                   void* recvbuf,
+                   int count,
+                   CollDataType type,
+                   CollComm global_comm,
+                   CollRequest* request);
+
+int collIallreduce(const void* sendbuf,
+                   void* recvbuf,
+                   int count,
+                   CollDataType type,
+                   CollReductionOp op,
+                   CollComm global_comm,
+                   CollRequest* request);
+
+int collTest(CollRequest* request, bool* completed);
+
+int collWait(CollRequest* request);
+
 int collInit(int argc, char* argv[]);
 
 int collFinalize();
 
+// Collective datatype of the elements of a Legate type
+CollDataType collDataTypeOf(legate_core_type_code_t code);
+
+// Registers a fixed-size opaque type whose elements are moved as size bytes each. Every process
+// must register the same types in the same order, after collInit. Registered types cannot be
+// used with the reduction collectives.
+int collTypeRegister(size_t size, CollDataType* type);
+
 int collGetUniqueId(int* id);
 
+// Fills in the telemetry of one kind of collective over all communicators of this process, and
+// returns 0 if telemetry is disabled
+int collGetStats(int kind, legate_cpucoll_stats_t* stats);
+
 int collInitComm();
 
 // The following functions should not be called by users
 #ifdef LEGATE_USE_NETWORK
 int alltoallvMPI(const void* sendbuf,
-                 const int sendcounts[],
-                 const int sdispls[],
+                 const int64_t sendcounts[],
+                 const int64_t sdispls[],
                  void* recvbuf,
-                 const int recvcounts[],
-                 const int rdispls[],
+                 const int64_t recvcounts[],
+                 const int64_t rdispls[],
                  CollDataType type,
                  CollComm global_comm);
 
 int alltoallMPI(
-  const void* sendbuf, void* recvbuf, int count, CollDataType type, CollComm global_comm);
+  const void* sendbuf, void* recvbuf, int64_t count, CollDataType type, CollComm global_comm);
+
+int alltoallvInplaceMPI(void* buf,
+                        const int64_t counts[],
+                        const int64_t displs[],
+                        CollDataType type,
+                        CollComm global_comm);
 
-int gatherMPI(
-  const void* sendbuf, void* recvbuf, int count, CollDataType type, int root, CollComm global_comm);
+int gatherMPI(const void* sendbuf,
+              void* recvbuf,
+              int64_t count,
+              CollDataType type,
+              int root,
+              CollComm global_comm);
 
 int allgatherMPI(
-  const void* sendbuf, void* recvbuf, int count, CollDataType type, CollComm global_comm);
+  const void* sendbuf, void* recvbuf, int64_t count, CollDataType type, CollComm global_comm);
 
-int bcastMPI(void* buf, int count, CollDataType type, int root, CollComm global_comm);
+int allgathervMPI(const void* sendbuf,
+                  int64_t sendcount,
+                  void* recvbuf,
+                  const int64_t recvcounts[],
+                  const int64_t displs[],
+                  CollDataType type,
+                  CollComm global_comm);
+
+int bcastMPI(void* buf, int64_t count, CollDataType type, int root, CollComm global_comm);
+
+int allreduceMPI(const void* sendbuf,
+                 void* recvbuf,
+                 int count,
+                 CollDataType type,
+                 CollReductionOp op,
+                 CollComm global_comm);
+
+int reduceMPI(const void* sendbuf,
+              void* recvbuf,
+              int count,
+              CollDataType type,
+              CollReductionOp op,
+              int root,
+              CollComm global_comm);
+
+int reduceScatterMPI(const void* sendbuf,
+                     void* recvbuf,
+                     int recvcount,
+                     CollDataType type,
+                     CollReductionOp op,
+                     CollComm global_comm);
 
 MPI_Datatype dtypeToMPIDtype(CollDataType dtype);
 
+// Point-to-point transfers of any number of elements. Counts that do not fit in an int are
+// sent with the MPI-4 large-count API when available and split into several messages
+// otherwise. The nonblocking versions append their requests to the given vector.
+void isendLarge(const void* buf,
+                int64_t count,
+                MPI_Datatype type,
+                int dest,
+                int tag,
+                MPI_Comm comm,
+                std::vector<MPI_Request>& requests);
+
+void irecvLarge(void* buf,
+                int64_t count,
+                MPI_Datatype type,
+                int source,
+                int tag,
+                MPI_Comm comm,
+                std::vector<MPI_Request>& requests);
+
+void sendLarge(const void* buf, int64_t count, MPI_Datatype type, int dest, int tag, MPI_Comm comm);
+
+void recvLarge(void* buf, int64_t count, MPI_Datatype type, int source, int tag, MPI_Comm comm);
+
+void sendrecvLarge(const void* sendbuf,
+                   int64_t sendcount,
+                   int dest,
+                   int sendtag,
+                   void* recvbuf,
+                   int64_t recvcount,
+                   int source,
+                   int recvtag,
+                   MPI_Datatype type,
+                   MPI_Comm comm);
+
 int generateAlltoallTag(int rank1, int rank2, CollComm global_comm);
 
 int generateAlltoallvTag(int rank1, int rank2, CollComm global_comm);
 
-int generateBcastTag(int rank, CollComm global_comm);
+int generateBcastTag(int rank1, int rank2, CollComm global_comm);
+
+int generateBcastRingTag(int rank1, int rank2, CollComm global_comm);
+
+int generateGatherTag(int rank1, int rank2, CollComm global_comm);
+
+int generateAllgathervTag(int rank1, int rank2, CollComm global_comm);
+
+int generateAllreduceTag(int rank1, int rank2, CollComm global_comm);
+
+int generateReduceTag(int rank1, int rank2, CollComm global_comm);
+
+int generateReduceScatterTag(int rank1, int rank2, CollComm global_comm);
+
+int generateIalltoallvTag(int rank1, int rank2, CollComm global_comm);
+
+int generateIallgatherTag(int rank1, int rank2, CollComm global_comm);
+
+int generateIallreduceTag(int rank1, int rank2, CollComm global_comm);
+
+// Largest tag generated on a communicator with nb_threads ranks in its most populated process
+int64_t generateMaxTag(int nb_threads);
+
+int ialltoallvMPI(const void* sendbuf,
+                  const int sendcounts[],
+                  const int sdispls[],
+                  void* recvbuf,
+                  const int recvcounts[],
+                  const int rdispls[],
+                  CollDataType type,
+                  CollComm global_comm,
+                  CollRequest* request);
+
+int iallgatherMPI(const void* sendbuf,
+                  void* recvbuf,
+                  int count,
+                  CollDataType type,
+                  CollComm global_comm,
+                  CollRequest* request);
 
-int generateGatherTag(int rank, CollComm global_comm);
+int iallreduceMPI(const void* sendbuf,
+                  void* recvbuf,
+                  int count,
+                  CollDataType type,
+                  CollReductionOp op,
+                  CollComm global_comm,
+                  CollRequest* request);
+
+int requestTestMPI(CollRequest* request, bool* completed);
+
+int requestWaitMPI(CollRequest* request);
 #else
 size_t getDtypeSize(CollDataType dtype);
 
 int alltoallvLocal(const void* sendbuf,
-                   const int sendcounts[],
-                   const int sdispls[],
+                   const int64_t sendcounts[],
+                   const int64_t sdispls[],
                    void* recvbuf,
-                   const int recvcounts[],
-                   const int rdispls[],
+                   const int64_t recvcounts[],
+                   const int64_t rdispls[],
                    CollDataType type,
                    CollComm global_comm);
 
 int alltoallLocal(
-  const void* sendbuf, void* recvbuf, int count, CollDataType type, CollComm global_comm);
+  const void* sendbuf, void* recvbuf, int64_t count, CollDataType type, CollComm global_comm);
+
+int alltoallvInplaceLocal(void* buf,
+                          const int64_t counts[],
+                          const int64_t displs[],
+                          CollDataType type,
+                          CollComm global_comm);
 
 int allgatherLocal(
-  const void* sendbuf, void* recvbuf, int count, CollDataType type, CollComm global_comm);
+  const void* sendbuf, void* recvbuf, int64_t count, CollDataType type, CollComm global_comm);
+
+int allgathervLocal(const void* sendbuf,
+                    int64_t sendcount,
+                    void* recvbuf,
+                    const int64_t recvcounts[],
+                    const int64_t displs[],
+                    CollDataType type,
+                    CollComm global_comm);
+
+int bcastLocal(void* buf, int64_t count, CollDataType type, int root, CollComm global_comm);
+
+int gatherLocal(const void* sendbuf,
+                void* recvbuf,
+                int64_t count,
+                CollDataType type,
+                int root,
+                CollComm global_comm);
+
+int allreduceLocal(const void* sendbuf,
+                   void* recvbuf,
+                   int count,
+                   CollDataType type,
+                   CollReductionOp op,
+                   CollComm global_comm);
 
-void resetLocalBuffer(CollComm global_comm);
+int reduceLocal(const void* sendbuf,
+                void* recvbuf,
+                int count,
+                CollDataType type,
+                CollReductionOp op,
+                int root,
+                CollComm global_comm);
+
+int reduceScatterLocal(const void* sendbuf,
+                       void* recvbuf,
+                       int recvcount,
+                       CollDataType type,
+                       CollReductionOp op,
+                       CollComm global_comm);
+
+int ialltoallvLocal(const void* sendbuf,
+                    const int sendcounts[],
+                    const int sdispls[],
+                    void* recvbuf,
+                    const int recvcounts[],
+                    const int rdispls[],
+                    CollDataType type,
+                    CollComm global_comm,
+                    CollRequest* request);
+
+int iallgatherLocal(const void* sendbuf,
+                    void* recvbuf,
+                    int count,
+                    CollDataType type,
+                    CollComm global_comm,
+                    CollRequest* request);
+
+int iallreduceLocal(const void* sendbuf,
+                    void* recvbuf,
+                    int count,
+                    CollDataType type,
+                    CollReductionOp op,
+                    CollComm global_comm,
+                    CollRequest* request);
+
+int requestTestLocal(CollRequest* request, bool* completed);
+
+int requestWaitLocal(CollRequest* request);
+#endif
+
+// Synchronization among the ranks of a communicator that share this process. Ranks are
+// indexed by local rank, which is the global rank in the thread-local backend.
+void publishLocalBuffer(CollComm global_comm,
+                        const void* buffer,
+                        const int64_t* displs = nullptr);
+
+void signalLocal(CollComm global_comm);
+
+void waitLocal(CollComm global_comm, int local_rank);
+
+// Nonblocking version of waitLocal
+bool pollLocal(CollComm global_comm, int local_rank);
 
 void barrierLocal(CollComm global_comm);
-#endif
 
 void* allocateInplaceBuffer(const void* recvbuf, size_t size);
 
+// Element-wise inout[i] = op(inout[i], in[i]) for the first count elements
+void applyReduction(
+  void* inout, const void* in, size_t count, CollDataType type, CollReductionOp op);
+
 #ifdef LEGATE_USE_NETWORK
 inline void check_mpi(int error, const char* file, int line)
 {
@@ -25,10 +25,10 @@ namespace legate {
 namespace comm {
 namespace cpu {
 
-static int init_cpucoll_mapping(const Legion::Task* task,
-                                const std::vector<Legion::PhysicalRegion>& regions,
-                                Legion::Context context,
-                                Legion::Runtime* runtime)
+static void init_cpucoll_mapping(const Legion::Task* task,
+                                 const std::vector<Legion::PhysicalRegion>& regions,
+                                 Legion::Context context,
+                                 Legion::Runtime* runtime)
 {
   Core::show_progress(task, context, runtime, task->get_task_name());
   int mpi_rank = 0;
@@ -36,7 +36,11 @@ static int init_cpucoll_mapping(const Legion::Task* task,
   MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
 #endif
 
-  return mpi_rank;
+  // Each point fills in its own entry of the mapping table
+  TaskContext ctx(task, regions, context, runtime);
+  auto& mapping_table = ctx.outputs()[0];
+  auto acc            = mapping_table.write_accessor<int32_t, 1>();
+  acc[mapping_table.shape<1>().lo] = mpi_rank;
 }
 
 static coll::CollComm init_cpucoll(const Legion::Task* task,
@@ -49,17 +53,19 @@ static coll::CollComm init_cpucoll(const Legion::Task* task,
   const int point = task->index_point[0];
   int num_ranks   = task->index_domain.get_volume();
 
-  assert(task->futures.size() == static_cast<size_t>(num_ranks + 1));
+  assert(task->futures.size() == 1);
   const int unique_id = task->futures[0].get_result<int>();
 
   coll::CollComm comm = (coll::CollComm)malloc(sizeof(coll::Coll_Comm));
 
 #ifdef LEGATE_USE_NETWORK
+  // The whole mapping table is broadcast to every point as a single read-only store
+  TaskContext ctx(task, regions, context, runtime);
+  auto& mapping_table_store = ctx.inputs()[0];
+  assert(mapping_table_store.shape<1>().volume() == static_cast<size_t>(num_ranks));
+  auto acc           = mapping_table_store.read_accessor<int32_t, 1>();
   int* mapping_table = (int*)malloc(sizeof(int) * num_ranks);
-  for (int i = 0; i < num_ranks; i++) {
-    const int mapping_table_element = task->futures[i + 1].get_result<int>();
-    mapping_table[i]                = mapping_table_element;
-  }
+  for (int i = 0; i < num_ranks; i++) { mapping_table[i] = acc[Point<1>(i)]; }
   coll::collCommCreate(comm, num_ranks, point, unique_id, mapping_table);
   assert(mapping_table[point] == comm->mpi_rank);
   free(mapping_table);
@@ -125,7 +131,7 @@ void register_tasks(Legion::Machine machine,
   {
     auto registrar = make_registrar(
       init_cpucoll_mapping_task_id, init_cpucoll_mapping_task_name, Processor::LOC_PROC);
-    runtime->register_task_variant<int, init_cpucoll_mapping>(registrar, LEGATE_CPU_VARIANT);
+    runtime->register_task_variant<init_cpucoll_mapping>(registrar, LEGATE_CPU_VARIANT);
   }
   {
     auto registrar =
@@ -140,7 +146,7 @@ void register_tasks(Legion::Machine machine,
   {
     auto registrar = make_registrar(
       init_cpucoll_mapping_task_id, init_cpucoll_mapping_task_name, Processor::OMP_PROC);
-    runtime->register_task_variant<int, init_cpucoll_mapping>(registrar, LEGATE_OMP_VARIANT);
+    runtime->register_task_variant<init_cpucoll_mapping>(registrar, LEGATE_OMP_VARIANT);
   }
   {
     auto registrar =
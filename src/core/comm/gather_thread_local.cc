@@ -0,0 +1,77 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "coll.h"
+#include "legion.h"
+
+namespace legate {
+namespace comm {
+namespace coll {
+
+using namespace Legion;
+extern Logger log_coll;
+
+int gatherLocal(const void* sendbuf,
+                void* recvbuf,
+                int64_t count,
+                CollDataType type,
+                int root,
+                CollComm global_comm)
+{
+  int total_size  = global_comm->global_comm_size;
+  int global_rank = global_comm->global_rank;
+
+  int type_extent = getDtypeSize(type);
+
+  publishLocalBuffer(global_comm, sendbuf);
+
+  if (global_rank == root) {
+    for (int recvfrom_global_rank = 0; recvfrom_global_rank < total_size;
+         recvfrom_global_rank++) {
+      // wait for other threads to update the buffer address
+      waitLocal(global_comm, recvfrom_global_rank);
+      const void* src = global_comm->comm->slots[recvfrom_global_rank].buffer;
+      char* dst       = static_cast<char*>(recvbuf) +
+                  static_cast<ptrdiff_t>(recvfrom_global_rank) * type_extent * count;
+#ifdef DEBUG_LEGATE
+      log_coll.debug(
+        "GatherLocal i: %d === global_rank %d, dtype %d, copy rank %d (%p) to rank %d (%p)",
+        recvfrom_global_rank,
+        global_rank,
+        type_extent,
+        recvfrom_global_rank,
+        src,
+        global_rank,
+        dst);
+#endif
+      memcpy(dst, src, count * type_extent);
+    }
+  }
+
+  // Keep the published buffer alive until the root is done reading from it
+  barrierLocal(global_comm);
+
+  return CollSuccess;
+}
+
+}  // namespace coll
+}  // namespace comm
+}  // namespace legate
@@ -18,6 +18,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
 
 #include "coll.h"
 #include "legion.h"
@@ -29,11 +30,13 @@ namespace coll {
 using namespace Legion;
 extern Logger log_coll;
 
-int gatherMPI(
-  const void* sendbuf, void* recvbuf, int count, CollDataType type, int root, CollComm global_comm)
+int gatherMPI(const void* sendbuf,
+              void* recvbuf,
+              int64_t count,
+              CollDataType type,
+              int root,
+              CollComm global_comm)
 {
-  MPI_Status status;
-
   int total_size  = global_comm->global_comm_size;
   int global_rank = global_comm->global_rank;
 
@@ -42,56 +45,77 @@ int gatherMPI(
   // Should not see inplace here
   if (sendbuf == recvbuf) { assert(0); }
 
-  int root_mpi_rank = global_comm->mapping_table.mpi_rank[root];
   assert(root == global_comm->mapping_table.global_rank[root]);
 
-  int tag;
+  MPI_Aint lb, type_extent;
+  MPI_Type_get_extent(mpi_type, &lb, &type_extent);
+  size_t seg_size = type_extent * static_cast<size_t>(count);
+
+  // Binomial tree on the rank relative to the root: a rank collects the segments of its
+  // subtree, the relative ranks [relative_rank, relative_rank + mask), from the partners below
+  // its lowest set bit and forwards them in one message to the partner that differs in that bit
+  int relative_rank = (global_rank + total_size - root) % total_size;
+  int mask          = 1;
+  while (mask < total_size && !(relative_rank & mask)) { mask <<= 1; }
+  int subtree_size = std::min(mask, total_size - relative_rank);
+
+  // Leaves send straight from sendbuf, and a root at rank 0 receives straight into recvbuf
+  char* acc = nullptr;
+  if (subtree_size == 1) {
+    acc = static_cast<char*>(const_cast<void*>(sendbuf));
+  } else if (relative_rank == 0 && root == 0) {
+    acc = static_cast<char*>(recvbuf);
+  } else {
+    acc = static_cast<char*>(malloc(seg_size * subtree_size));
+    assert(acc != nullptr);
+  }
+  if (acc != sendbuf) { memcpy(acc, sendbuf, seg_size); }
 
-  // non-root
-  if (global_rank != root) {
-    tag = generateGatherTag(global_rank, global_comm);
+  for (int child_mask = 1; child_mask < mask; child_mask <<= 1) {
+    int child = relative_rank + child_mask;
+    if (child >= total_size) { break; }
+    int recvfrom_global_rank = (child + root) % total_size;
+    int recvfrom_mpi_rank    = global_comm->mapping_table.mpi_rank[recvfrom_global_rank];
+    int tag = generateGatherTag(global_rank, recvfrom_global_rank, global_comm);
+    int64_t recv_count = count * std::min(child_mask, total_size - child);
 #ifdef DEBUG_LEGATE
-    log_coll.debug("GatherMPI: non-root send global_rank %d, mpi rank %d, send to %d (%d), tag %d",
+    log_coll.debug("GatherMPI: global_rank %d, mpi rank %d, recv from %d (%d), tag %d",
                    global_rank,
                    global_comm->mpi_rank,
-                   root,
-                   root_mpi_rank,
+                   recvfrom_global_rank,
+                   recvfrom_mpi_rank,
                    tag);
 #endif
-    CHECK_MPI(MPI_Send(sendbuf, count, mpi_type, root_mpi_rank, tag, global_comm->comm));
-    return CollSuccess;
+    recvLarge(acc + static_cast<ptrdiff_t>(child_mask) * seg_size,
+              recv_count,
+              mpi_type,
+              recvfrom_mpi_rank,
+              tag,
+              global_comm->comm);
   }
 
-  // root
-  MPI_Aint incr, lb, type_extent;
-  MPI_Type_get_extent(mpi_type, &lb, &type_extent);
-  incr      = type_extent * static_cast<ptrdiff_t>(count);
-  char* dst = static_cast<char*>(recvbuf);
-  int recvfrom_mpi_rank;
-  for (int i = 0; i < total_size; i++) {
-    recvfrom_mpi_rank = global_comm->mapping_table.mpi_rank[i];
-    assert(i == global_comm->mapping_table.global_rank[i]);
-    tag = generateGatherTag(i, global_comm);
+  if (relative_rank != 0) {
+    int sendto_global_rank = (relative_rank - mask + root) % total_size;
+    int sendto_mpi_rank    = global_comm->mapping_table.mpi_rank[sendto_global_rank];
+    int tag                = generateGatherTag(sendto_global_rank, global_rank, global_comm);
 #ifdef DEBUG_LEGATE
-    log_coll.debug(
-      "GatherMPI: root i %d === global_rank %d, mpi rank %d, recv %p, from %d (%d), tag %d",
-      i,
-      global_rank,
-      global_comm->mpi_rank,
-      dst,
-      i,
-      recvfrom_mpi_rank,
-      tag);
+    log_coll.debug("GatherMPI: global_rank %d, mpi rank %d, send to %d (%d), tag %d",
+                   global_rank,
+                   global_comm->mpi_rank,
+                   sendto_global_rank,
+                   sendto_mpi_rank,
+                   tag);
 #endif
-    assert(dst != nullptr);
-    if (global_rank == i) {
-      memcpy(dst, sendbuf, incr);
-    } else {
-      CHECK_MPI(MPI_Recv(dst, count, mpi_type, recvfrom_mpi_rank, tag, global_comm->comm, &status));
-    }
-    dst += incr;
+    sendLarge(acc, count * subtree_size, mpi_type, sendto_mpi_rank, tag, global_comm->comm);
+  } else if (acc != recvbuf) {
+    // The segments arrived in relative rank order, rotate them back to rank order
+    size_t head = seg_size * (total_size - root);
+    memcpy(static_cast<char*>(recvbuf) + seg_size * root, acc, head);
+    memcpy(recvbuf, acc + head, seg_size * root);
   }
 
+  if (acc != sendbuf && acc != recvbuf) { free(acc); }
+
   return CollSuccess;
 }
 
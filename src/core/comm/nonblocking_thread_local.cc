@@ -0,0 +1,246 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "coll.h"
+#include "legion.h"
+
+namespace legate {
+namespace comm {
+namespace coll {
+
+using namespace Legion;
+extern Logger log_coll;
+
+enum class RequestKind : int {
+  Alltoallv = 0,
+  Allgather = 1,
+  Allreduce = 2,
+};
+
+// A nonblocking collective publishes its send buffer and then pulls the blocks of each peer as
+// soon as that peer has published, whenever the request is tested or waited on. Once every
+// block has been pulled the rank signals that it is done reading, and the request completes
+// when all peers have signaled the same, as they may still be reading our send buffer.
+struct Coll_Request {
+  CollComm global_comm;
+  RequestKind kind;
+  // Per-peer completion flags of the current phase
+  std::vector<bool> peer_done;
+  int nb_pending;
+  bool signaled;
+  void* recvbuf;
+  int64_t count;
+  size_t type_extent;
+  CollDataType type;
+  CollReductionOp op;
+  std::vector<int64_t> sdispls;
+  std::vector<int64_t> recvcounts;
+  std::vector<int64_t> rdispls;
+  // Private copy of the contribution of an in-place Iallreduce
+  std::vector<char> scratch;
+};
+
+static Coll_Request* createRequest(CollComm global_comm, RequestKind kind, CollDataType type)
+{
+  int total_size    = global_comm->global_comm_size;
+  Coll_Request* req = new Coll_Request;
+  req->global_comm  = global_comm;
+  req->kind         = kind;
+  req->nb_pending   = total_size - 1;
+  req->signaled     = false;
+  req->recvbuf      = nullptr;
+  req->count        = 0;
+  req->type_extent  = getDtypeSize(type);
+  req->type         = type;
+  req->op           = CollReductionOp::CollSum;
+  req->peer_done.assign(total_size, false);
+  req->peer_done[global_comm->global_rank] = true;
+  return req;
+}
+
+static void copyFromPeer(Coll_Request* req, int peer)
+{
+  CollComm global_comm       = req->global_comm;
+  const ThreadCommSlot& slot = global_comm->comm->slots[peer];
+  const char* src_base       = static_cast<const char*>(slot.buffer);
+  char* dst_base             = static_cast<char*>(req->recvbuf);
+  switch (req->kind) {
+    case RequestKind::Alltoallv: {
+      const char* src =
+        src_base + static_cast<ptrdiff_t>(slot.displs[global_comm->global_rank]) * req->type_extent;
+      char* dst = dst_base + static_cast<ptrdiff_t>(req->rdispls[peer]) * req->type_extent;
+      memcpy(dst, src, req->recvcounts[peer] * req->type_extent);
+      break;
+    }
+    case RequestKind::Allgather: {
+      char* dst = dst_base + static_cast<ptrdiff_t>(peer) * req->count * req->type_extent;
+      memcpy(dst, src_base, req->count * req->type_extent);
+      break;
+    }
+    case RequestKind::Allreduce: {
+      // Contributions are combined once all of them are available, so that every rank reduces
+      // them in the same order and ends up with bitwise identical results
+      break;
+    }
+  }
+}
+
+// Makes as much progress as possible without blocking, unless asked to, and returns whether the
+// request has completed
+static bool progressRequest(Coll_Request* req, bool blocking)
+{
+  CollComm global_comm = req->global_comm;
+  int total_size       = global_comm->global_comm_size;
+  int global_rank      = global_comm->global_rank;
+
+  for (int peer = 0; peer < total_size && req->nb_pending > 0; peer++) {
+    if (req->peer_done[peer]) { continue; }
+    if (blocking) {
+      waitLocal(global_comm, peer);
+    } else if (!pollLocal(global_comm, peer)) {
+      continue;
+    }
+    if (!req->signaled) { copyFromPeer(req, peer); }
+    req->peer_done[peer] = true;
+    req->nb_pending--;
+  }
+  if (req->nb_pending > 0) { return false; }
+  if (req->signaled) { return true; }
+
+  if (req->kind == RequestKind::Allreduce) {
+    size_t size = req->count * req->type_extent;
+    memcpy(req->recvbuf, global_comm->comm->slots[0].buffer, size);
+    for (int i = 1; i < total_size; i++) {
+      applyReduction(
+        req->recvbuf, global_comm->comm->slots[i].buffer, req->count, req->type, req->op);
+    }
+  }
+
+  // Move on to waiting for the peers to be done with our send buffer
+  signalLocal(global_comm);
+  req->signaled   = true;
+  req->nb_pending = total_size - 1;
+  req->peer_done.assign(total_size, false);
+  req->peer_done[global_rank] = true;
+  return progressRequest(req, blocking);
+}
+
+int ialltoallvLocal(const void* sendbuf,
+                    const int sendcounts[],
+                    const int sdispls[],
+                    void* recvbuf,
+                    const int recvcounts[],
+                    const int rdispls[],
+                    CollDataType type,
+                    CollComm global_comm,
+                    CollRequest* request)
+{
+  int total_size  = global_comm->global_comm_size;
+  int global_rank = global_comm->global_rank;
+
+  Coll_Request* req = createRequest(global_comm, RequestKind::Alltoallv, type);
+  req->recvbuf      = recvbuf;
+  req->sdispls.assign(sdispls, sdispls + total_size);
+  req->recvcounts.assign(recvcounts, recvcounts + total_size);
+  req->rdispls.assign(rdispls, rdispls + total_size);
+
+  size_t type_extent = req->type_extent;
+  memcpy(static_cast<char*>(recvbuf) + static_cast<ptrdiff_t>(rdispls[global_rank]) * type_extent,
+         static_cast<const char*>(sendbuf) +
+           static_cast<ptrdiff_t>(sdispls[global_rank]) * type_extent,
+         static_cast<size_t>(sendcounts[global_rank]) * type_extent);
+  publishLocalBuffer(global_comm, sendbuf, req->sdispls.data());
+  progressRequest(req, false);
+
+  *request = req;
+  return CollSuccess;
+}
+
+int iallgatherLocal(const void* sendbuf,
+                    void* recvbuf,
+                    int count,
+                    CollDataType type,
+                    CollComm global_comm,
+                    CollRequest* request)
+{
+  Coll_Request* req = createRequest(global_comm, RequestKind::Allgather, type);
+  req->recvbuf      = recvbuf;
+  req->count        = count;
+
+  size_t size = req->count * req->type_extent;
+  memcpy(static_cast<char*>(recvbuf) + static_cast<ptrdiff_t>(global_comm->global_rank) * size,
+         sendbuf,
+         size);
+  publishLocalBuffer(global_comm, sendbuf);
+  progressRequest(req, false);
+
+  *request = req;
+  return CollSuccess;
+}
+
+int iallreduceLocal(const void* sendbuf,
+                    void* recvbuf,
+                    int count,
+                    CollDataType type,
+                    CollReductionOp op,
+                    CollComm global_comm,
+                    CollRequest* request)
+{
+  Coll_Request* req = createRequest(global_comm, RequestKind::Allreduce, type);
+  req->recvbuf      = recvbuf;
+  req->count        = count;
+  req->op           = op;
+
+  // IN_PLACE: peers read our contribution while we write the result
+  if (sendbuf == recvbuf) {
+    const char* src = static_cast<const char*>(sendbuf);
+    req->scratch.assign(src, src + req->count * req->type_extent);
+    sendbuf = req->scratch.data();
+  }
+  publishLocalBuffer(global_comm, sendbuf);
+  progressRequest(req, false);
+
+  *request = req;
+  return CollSuccess;
+}
+
+int requestTestLocal(CollRequest* request, bool* completed)
+{
+  *completed = progressRequest(*request, false);
+  if (*completed) {
+    delete *request;
+    *request = nullptr;
+  }
+  return CollSuccess;
+}
+
+int requestWaitLocal(CollRequest* request)
+{
+  progressRequest(*request, true);
+  delete *request;
+  *request = nullptr;
+  return CollSuccess;
+}
+
+}  // namespace coll
+}  // namespace comm
+}  // namespace legate
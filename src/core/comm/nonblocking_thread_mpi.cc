@@ -0,0 +1,241 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "coll.h"
+#include "legion.h"
+
+namespace legate {
+namespace comm {
+namespace coll {
+
+using namespace Legion;
+extern Logger log_coll;
+
+// All messages of a nonblocking collective are posted up front, so the MPI progress engine moves
+// the data while the caller keeps computing
+struct Coll_Request {
+  CollComm global_comm;
+  std::vector<MPI_Request> requests;
+  // Iallreduce gathers every contribution into the scratch buffer, in rank order, and reduces
+  // them into the receive buffer once they have all arrived
+  std::vector<char> scratch;
+  void* recvbuf;
+  int64_t count;
+  CollDataType type;
+  CollReductionOp op;
+  bool reduce;
+};
+
+typedef int (*TagGenerator)(int rank1, int rank2, CollComm global_comm);
+
+static Coll_Request* createRequest(CollComm global_comm)
+{
+  Coll_Request* req = new Coll_Request;
+  req->global_comm  = global_comm;
+  req->recvbuf      = nullptr;
+  req->count        = 0;
+  req->type         = CollDataType::CollInt8;
+  req->op           = CollReductionOp::CollSum;
+  req->reduce       = false;
+  return req;
+}
+
+static void completeRequest(CollRequest* request)
+{
+  Coll_Request* req = *request;
+  if (req->reduce) {
+    MPI_Aint lb, type_extent;
+    MPI_Type_get_extent(dtypeToMPIDtype(req->type), &lb, &type_extent);
+    size_t seg_size = req->count * type_extent;
+    memcpy(req->recvbuf, req->scratch.data(), seg_size);
+    for (int i = 1; i < req->global_comm->global_comm_size; i++) {
+      applyReduction(req->recvbuf,
+                     req->scratch.data() + static_cast<ptrdiff_t>(i) * seg_size,
+                     req->count,
+                     req->type,
+                     req->op);
+    }
+  }
+  delete req;
+  *request = nullptr;
+}
+
+// Posts the exchange of count elements of sendbuf with every other rank, the block of rank i
+// landing at offset i * count of recvbuf
+static void postAllgather(Coll_Request* req,
+                          const void* sendbuf,
+                          void* recvbuf,
+                          int64_t count,
+                          CollDataType type,
+                          TagGenerator generate_tag)
+{
+  MPI_Aint lb, type_extent;
+  MPI_Datatype mpi_type = dtypeToMPIDtype(type);
+  MPI_Type_get_extent(mpi_type, &lb, &type_extent);
+
+  CollComm global_comm = req->global_comm;
+  int total_size       = global_comm->global_comm_size;
+  int global_rank      = global_comm->global_rank;
+  size_t seg_size      = count * type_extent;
+
+  for (int i = 1; i < total_size; i++) {
+    int recvfrom_global_rank = (global_rank + total_size - i) % total_size;
+    int recvfrom_mpi_rank    = global_comm->mapping_table.mpi_rank[recvfrom_global_rank];
+    int recv_tag             = generate_tag(global_rank, recvfrom_global_rank, global_comm);
+    char* dst =
+      static_cast<char*>(recvbuf) + static_cast<ptrdiff_t>(recvfrom_global_rank) * seg_size;
+    irecvLarge(
+      dst, count, mpi_type, recvfrom_mpi_rank, recv_tag, global_comm->comm, req->requests);
+  }
+  for (int i = 1; i < total_size; i++) {
+    int sendto_global_rank = (global_rank + i) % total_size;
+    int sendto_mpi_rank    = global_comm->mapping_table.mpi_rank[sendto_global_rank];
+    int send_tag           = generate_tag(sendto_global_rank, global_rank, global_comm);
+    isendLarge(
+      sendbuf, count, mpi_type, sendto_mpi_rank, send_tag, global_comm->comm, req->requests);
+  }
+  char* dst = static_cast<char*>(recvbuf) + static_cast<ptrdiff_t>(global_rank) * seg_size;
+  if (dst != sendbuf) { memcpy(dst, sendbuf, seg_size); }
+}
+
+int ialltoallvMPI(const void* sendbuf,
+                  const int sendcounts[],
+                  const int sdispls[],
+                  void* recvbuf,
+                  const int recvcounts[],
+                  const int rdispls[],
+                  CollDataType type,
+                  CollComm global_comm,
+                  CollRequest* request)
+{
+  MPI_Aint lb, type_extent;
+  MPI_Datatype mpi_type = dtypeToMPIDtype(type);
+  MPI_Type_get_extent(mpi_type, &lb, &type_extent);
+
+  int total_size  = global_comm->global_comm_size;
+  int global_rank = global_comm->global_rank;
+
+  Coll_Request* req = createRequest(global_comm);
+
+  // Receives are posted first so that most messages land directly in the user buffer
+  for (int i = 1; i < total_size; i++) {
+    int recvfrom_global_rank = (global_rank + total_size - i) % total_size;
+    if (recvcounts[recvfrom_global_rank] == 0) { continue; }
+    int recvfrom_mpi_rank = global_comm->mapping_table.mpi_rank[recvfrom_global_rank];
+    int recv_tag          = generateIalltoallvTag(global_rank, recvfrom_global_rank, global_comm);
+    char* dst             = static_cast<char*>(recvbuf) +
+                static_cast<ptrdiff_t>(rdispls[recvfrom_global_rank]) * type_extent;
+    irecvLarge(dst,
+               recvcounts[recvfrom_global_rank],
+               mpi_type,
+               recvfrom_mpi_rank,
+               recv_tag,
+               global_comm->comm,
+               req->requests);
+  }
+  for (int i = 1; i < total_size; i++) {
+    int sendto_global_rank = (global_rank + i) % total_size;
+    if (sendcounts[sendto_global_rank] == 0) { continue; }
+    int sendto_mpi_rank = global_comm->mapping_table.mpi_rank[sendto_global_rank];
+    int send_tag        = generateIalltoallvTag(sendto_global_rank, global_rank, global_comm);
+    const char* src     = static_cast<const char*>(sendbuf) +
+                      static_cast<ptrdiff_t>(sdispls[sendto_global_rank]) * type_extent;
+    isendLarge(src,
+               sendcounts[sendto_global_rank],
+               mpi_type,
+               sendto_mpi_rank,
+               send_tag,
+               global_comm->comm,
+               req->requests);
+  }
+  memcpy(static_cast<char*>(recvbuf) + static_cast<ptrdiff_t>(rdispls[global_rank]) * type_extent,
+         static_cast<const char*>(sendbuf) +
+           static_cast<ptrdiff_t>(sdispls[global_rank]) * type_extent,
+         static_cast<size_t>(sendcounts[global_rank]) * type_extent);
+
+  *request = req;
+  return CollSuccess;
+}
+
+int iallgatherMPI(const void* sendbuf,
+                  void* recvbuf,
+                  int count,
+                  CollDataType type,
+                  CollComm global_comm,
+                  CollRequest* request)
+{
+  Coll_Request* req = createRequest(global_comm);
+  postAllgather(req, sendbuf, recvbuf, count, type, generateIallgatherTag);
+  *request = req;
+  return CollSuccess;
+}
+
+int iallreduceMPI(const void* sendbuf,
+                  void* recvbuf,
+                  int count,
+                  CollDataType type,
+                  CollReductionOp op,
+                  CollComm global_comm,
+                  CollRequest* request)
+{
+  MPI_Aint lb, type_extent;
+  MPI_Type_get_extent(dtypeToMPIDtype(type), &lb, &type_extent);
+  size_t seg_size = static_cast<size_t>(count) * type_extent;
+
+  Coll_Request* req = createRequest(global_comm);
+  req->recvbuf      = recvbuf;
+  req->count        = count;
+  req->type         = type;
+  req->op           = op;
+  req->reduce       = true;
+  req->scratch.resize(seg_size * global_comm->global_comm_size);
+
+  // Our own contribution is sent from the scratch buffer, which keeps in-place calls safe
+  char* own_seg =
+    req->scratch.data() + static_cast<ptrdiff_t>(global_comm->global_rank) * seg_size;
+  memcpy(own_seg, sendbuf, seg_size);
+  postAllgather(req, own_seg, req->scratch.data(), count, type, generateIallreduceTag);
+  *request = req;
+  return CollSuccess;
+}
+
+int requestTestMPI(CollRequest* request, bool* completed)
+{
+  Coll_Request* req = *request;
+  int flag          = 0;
+  CHECK_MPI(MPI_Testall(req->requests.size(), req->requests.data(), &flag, MPI_STATUSES_IGNORE));
+  *completed = flag != 0;
+  if (*completed) { completeRequest(request); }
+  return CollSuccess;
+}
+
+int requestWaitMPI(CollRequest* request)
+{
+  Coll_Request* req = *request;
+  CHECK_MPI_WAIT(MPI_Waitall(req->requests.size(), req->requests.data(), MPI_STATUSES_IGNORE));
+  completeRequest(request);
+  return CollSuccess;
+}
+
+}  // namespace coll
+}  // namespace comm
+}  // namespace legate
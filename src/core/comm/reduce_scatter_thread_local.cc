@@ -0,0 +1,77 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "coll.h"
+#include "legion.h"
+
+namespace legate {
+namespace comm {
+namespace coll {
+
+using namespace Legion;
+extern Logger log_coll;
+
+
+int reduceScatterLocal(const void* sendbuf,
+                       void* recvbuf,
+                       int recvcount,
+                       CollDataType type,
+                       CollReductionOp op,
+                       CollComm global_comm)
+{
+  int total_size  = global_comm->global_comm_size;
+  int global_rank = global_comm->global_rank;
+
+  size_t type_extent = getDtypeSize(type);
+
+  publishLocalBuffer(global_comm, sendbuf);
+
+  size_t seg_offset = static_cast<size_t>(global_rank) * recvcount * type_extent;
+  memcpy(recvbuf, static_cast<const char*>(sendbuf) + seg_offset, recvcount * type_extent);
+  for (int i = 1; i < total_size; i++) {
+    int recvfrom_global_rank = (global_rank + i) % total_size;
+    waitLocal(global_comm, recvfrom_global_rank);
+    const char* src =
+      static_cast<const char*>(global_comm->comm->slots[recvfrom_global_rank].buffer) + seg_offset;
+#ifdef DEBUG_LEGATE
+    log_coll.debug(
+      "ReduceScatterLocal i: %d === global_rank %d, dtype %zu, reduce rank %d (seg %d, %p) into "
+      "%p",
+      i,
+      global_rank,
+      type_extent,
+      recvfrom_global_rank,
+      global_rank,
+      src,
+      recvbuf);
+#endif
+    applyReduction(recvbuf, src, recvcount, type, op);
+  }
+
+  // Keep the published buffer alive until every peer is done reading from it
+  barrierLocal(global_comm);
+
+  return CollSuccess;
+}
+
+}  // namespace coll
+}  // namespace comm
+}  // namespace legate
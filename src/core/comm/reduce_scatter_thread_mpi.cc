@@ -0,0 +1,114 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+#include "coll.h"
+#include "legion.h"
+
+namespace legate {
+namespace comm {
+namespace coll {
+
+using namespace Legion;
+extern Logger log_coll;
+
+int reduceScatterMPI(const void* sendbuf,
+                     void* recvbuf,
+                     int recvcount,
+                     CollDataType type,
+                     CollReductionOp op,
+                     CollComm global_comm)
+{
+  MPI_Status status;
+
+  int total_size  = global_comm->global_comm_size;
+  int global_rank = global_comm->global_rank;
+
+  MPI_Datatype mpi_type = dtypeToMPIDtype(type);
+
+  MPI_Aint lb, type_extent;
+  MPI_Type_get_extent(mpi_type, &lb, &type_extent);
+
+  size_t seg_bytes = type_extent * static_cast<size_t>(recvcount);
+  auto seg_ptr     = [&](int seg) {
+    return static_cast<const char*>(sendbuf) + static_cast<ptrdiff_t>(seg) * seg_bytes;
+  };
+
+  if (total_size == 1) {
+    memcpy(recvbuf, sendbuf, seg_bytes);
+    return CollSuccess;
+  }
+
+  int sendto_global_rank   = (global_rank + 1) % total_size;
+  int recvfrom_global_rank = (global_rank + total_size - 1) % total_size;
+  int sendto_mpi_rank      = global_comm->mapping_table.mpi_rank[sendto_global_rank];
+  int recvfrom_mpi_rank    = global_comm->mapping_table.mpi_rank[recvfrom_global_rank];
+  int send_tag = generateReduceScatterTag(sendto_global_rank, global_rank, global_comm);
+  int recv_tag = generateReduceScatterTag(global_rank, recvfrom_global_rank, global_comm);
+
+  // Ring: the partial sum of each segment travels around the ring picking up one
+  // contribution per hop, so that segment global_rank arrives here fully reduced
+  void* acc = malloc(seg_bytes);
+  void* tmp = malloc(seg_bytes);
+  assert(acc != nullptr && tmp != nullptr);
+  for (int i = 0; i < total_size - 1; i++) {
+    int send_seg    = (global_rank + total_size - i - 1) % total_size;
+    int recv_seg    = (global_rank + total_size - i - 2) % total_size;
+    const void* src = i == 0 ? seg_ptr(send_seg) : acc;
+    void* dst       = i == total_size - 2 ? recvbuf : acc;
+#ifdef DEBUG_LEGATE
+    log_coll.debug(
+      "ReduceScatterMPI i: %d === global_rank %d, mpi rank %d, send seg %d to %d (%d), recv seg "
+      "%d from %d (%d)",
+      i,
+      global_rank,
+      global_comm->mpi_rank,
+      send_seg,
+      sendto_global_rank,
+      sendto_mpi_rank,
+      recv_seg,
+      recvfrom_global_rank,
+      recvfrom_mpi_rank);
+#endif
+    CHECK_MPI_WAIT(MPI_Sendrecv(src,
+                                recvcount,
+                                mpi_type,
+                                sendto_mpi_rank,
+                                send_tag,
+                                tmp,
+                                recvcount,
+                                mpi_type,
+                                recvfrom_mpi_rank,
+                                recv_tag,
+                                global_comm->comm,
+                                &status));
+    memcpy(dst, seg_ptr(recv_seg), seg_bytes);
+    applyReduction(dst, tmp, recvcount, type, op);
+  }
+  free(acc);
+  free(tmp);
+
+  return CollSuccess;
+}
+
+}  // namespace coll
+}  // namespace comm
+}  // namespace legate
@@ -0,0 +1,91 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "coll.h"
+#include "legion.h"
+
+namespace legate {
+namespace comm {
+namespace coll {
+
+using namespace Legion;
+extern Logger log_coll;
+
+
+int reduceLocal(const void* sendbuf,
+                void* recvbuf,
+                int count,
+                CollDataType type,
+                CollReductionOp op,
+                int root,
+                CollComm global_comm)
+{
+  int total_size  = global_comm->global_comm_size;
+  int global_rank = global_comm->global_rank;
+
+  size_t type_extent = getDtypeSize(type);
+
+  // The root accumulates into its recvbuf, so it publishes that instead of its sendbuf.
+  // Every rank then reduces its own segment of all contributions into the root's recvbuf.
+  if (global_rank == root) {
+    if (sendbuf != recvbuf) { memcpy(recvbuf, sendbuf, count * type_extent); }
+    publishLocalBuffer(global_comm, recvbuf);
+  } else {
+    publishLocalBuffer(global_comm, sendbuf);
+  }
+
+  size_t seg_start = static_cast<size_t>(count) * global_rank / total_size;
+  size_t seg_end   = static_cast<size_t>(count) * (global_rank + 1) / total_size;
+  waitLocal(global_comm, root);
+  char* dst = static_cast<char*>(const_cast<void*>(global_comm->comm->slots[root].buffer)) +
+              seg_start * type_extent;
+  for (int i = 1; i < total_size; i++) {
+    int recvfrom_global_rank = (root + i) % total_size;
+    waitLocal(global_comm, recvfrom_global_rank);
+    const char* src =
+      static_cast<const char*>(global_comm->comm->slots[recvfrom_global_rank].buffer) +
+      seg_start * type_extent;
+#ifdef DEBUG_LEGATE
+    log_coll.debug(
+      "ReduceLocal i: %d === global_rank %d, dtype %zu, reduce rank %d (%p) into root %d seg "
+      "[%zu, %zu) (%p)",
+      i,
+      global_rank,
+      type_extent,
+      recvfrom_global_rank,
+      src,
+      root,
+      seg_start,
+      seg_end,
+      dst);
+#endif
+    applyReduction(dst, src, seg_end - seg_start, type, op);
+  }
+
+  // Keep the published buffers alive until every rank is done with its segment
+  barrierLocal(global_comm);
+
+  return CollSuccess;
+}
+
+}  // namespace coll
+}  // namespace comm
+}  // namespace legate
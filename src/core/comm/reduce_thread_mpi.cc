@@ -0,0 +1,114 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+#include "coll.h"
+#include "legion.h"
+
+namespace legate {
+namespace comm {
+namespace coll {
+
+using namespace Legion;
+extern Logger log_coll;
+
+int reduceMPI(const void* sendbuf,
+              void* recvbuf,
+              int count,
+              CollDataType type,
+              CollReductionOp op,
+              int root,
+              CollComm global_comm)
+{
+  MPI_Status status;
+
+  int total_size  = global_comm->global_comm_size;
+  int global_rank = global_comm->global_rank;
+
+  MPI_Datatype mpi_type = dtypeToMPIDtype(type);
+
+  MPI_Aint lb, type_extent;
+  MPI_Type_get_extent(mpi_type, &lb, &type_extent);
+
+  size_t bytes = type_extent * static_cast<size_t>(count);
+
+  // The root accumulates directly into its recvbuf, the other ranks into a scratch buffer
+  void* acc = nullptr;
+  if (global_rank == root) {
+    acc = recvbuf;
+    if (sendbuf != recvbuf) { memcpy(acc, sendbuf, bytes); }
+  } else {
+    acc = allocateInplaceBuffer(sendbuf, bytes);
+  }
+
+  if (total_size == 1) { return CollSuccess; }
+
+  void* tmp = malloc(bytes);
+  assert(tmp != nullptr);
+
+  // Binomial tree rooted at root: in round k, ranks whose relative rank has bit k set send
+  // their partial result to the partner 2^k below and drop out
+  int relative_rank = (global_rank + total_size - root) % total_size;
+  for (int mask = 1; mask < total_size; mask <<= 1) {
+    if (relative_rank & mask) {
+      int sendto_global_rank = (relative_rank - mask + root) % total_size;
+      int sendto_mpi_rank    = global_comm->mapping_table.mpi_rank[sendto_global_rank];
+      int tag                = generateReduceTag(sendto_global_rank, global_rank, global_comm);
+#ifdef DEBUG_LEGATE
+      log_coll.debug("ReduceMPI mask: %d === global_rank %d, mpi rank %d, send to %d (%d), tag %d",
+                     mask,
+                     global_rank,
+                     global_comm->mpi_rank,
+                     sendto_global_rank,
+                     sendto_mpi_rank,
+                     tag);
+#endif
+      CHECK_MPI_WAIT(MPI_Send(acc, count, mpi_type, sendto_mpi_rank, tag, global_comm->comm));
+      break;
+    } else if (relative_rank + mask < total_size) {
+      int recvfrom_global_rank = (relative_rank + mask + root) % total_size;
+      int recvfrom_mpi_rank    = global_comm->mapping_table.mpi_rank[recvfrom_global_rank];
+      int tag                  = generateReduceTag(global_rank, recvfrom_global_rank, global_comm);
+#ifdef DEBUG_LEGATE
+      log_coll.debug(
+        "ReduceMPI mask: %d === global_rank %d, mpi rank %d, recv from %d (%d), tag %d",
+        mask,
+        global_rank,
+        global_comm->mpi_rank,
+        recvfrom_global_rank,
+        recvfrom_mpi_rank,
+        tag);
+#endif
+      CHECK_MPI_WAIT(
+        MPI_Recv(tmp, count, mpi_type, recvfrom_mpi_rank, tag, global_comm->comm, &status));
+      applyReduction(acc, tmp, count, type, op);
+    }
+  }
+
+  free(tmp);
+  if (global_rank != root) { free(acc); }
+
+  return CollSuccess;
+}
+
+}  // namespace coll
+}  // namespace comm
+}  // namespace legate
@@ -0,0 +1,400 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Checks the reducing CPU collectives in coll.h against a serial reference.
+//
+// Every rank calls collAllreduce, collReduce and collReduceScatter for each data type, reduction
+// operator and element count, and compares what it receives with the values a serial loop over
+// the ranks computes. Complex values are only checked with the sum and the product, the only
+// operators they support. The inputs are small integers, so that every partial result is exact
+// and the reference does not depend on the order in which the ranks are combined.
+//
+// As with the benchmark, each process spawns one thread per local rank, and the network backend
+// is run under mpirun. The program exits with a non-zero status if any check fails.
+//
+// Usage: coll_reduction_test [-t 1,2,3,4]
+
+#include <getopt.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <atomic>
+#include <complex>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "legion.h"
+
+#include "core/comm/coll.h"
+
+using namespace legate::comm::coll;
+
+namespace {
+
+struct OpInfo {
+  const char* name;
+  CollReductionOp op;
+};
+
+const OpInfo OPS[] = {
+  {"sum", CollReductionOp::CollSum},
+  {"prod", CollReductionOp::CollProd},
+  {"min", CollReductionOp::CollMin},
+  {"max", CollReductionOp::CollMax},
+};
+
+// Element counts per rank, chosen to leave segments of uneven sizes
+const int COUNTS[] = {1, 3, 17, 1000};
+
+struct TestState {
+  int nb_threads;
+  int mpi_rank;
+  int mpi_comm_size;
+  int unique_id;
+  std::atomic<int> failures{0};
+};
+
+template <typename T>
+struct is_complex : std::false_type {};
+template <typename T>
+struct is_complex<std::complex<T>> : std::true_type {};
+
+// Inputs of the product are ones and twos, so that the product over all ranks stays exact, and
+// the other inputs range over [-3, 3], or [0, 6] for unsigned types
+template <typename T>
+T make_value(int rank, int idx, CollReductionOp op)
+{
+  if (op == CollReductionOp::CollProd) return static_cast<T>(1 + (rank + idx) % 2);
+  int value = (rank * 3 + idx * 5) % 7;
+  if (std::is_signed<T>::value) value -= 3;
+  return static_cast<T>(value);
+}
+
+template <>
+bool make_value<bool>(int rank, int idx, CollReductionOp op)
+{
+  return (rank + idx) % 3 != 0;
+}
+
+template <>
+__half make_value<__half>(int rank, int idx, CollReductionOp op)
+{
+  if (op == CollReductionOp::CollProd) return __half(static_cast<float>(1 + (rank + idx) % 2));
+  return __half(static_cast<float>((rank * 3 + idx * 5) % 7 - 3));
+}
+
+template <>
+std::complex<float> make_value<std::complex<float>>(int rank, int idx, CollReductionOp op)
+{
+  return std::complex<float>(1 + (rank + idx) % 2, (rank * idx) % 2);
+}
+
+template <>
+std::complex<double> make_value<std::complex<double>>(int rank, int idx, CollReductionOp op)
+{
+  return std::complex<double>(1 + (rank + idx) % 2, (rank * idx) % 2);
+}
+
+// Serial reference of the reduction operators, with the semantics of applyReduction in coll.cc
+template <typename T>
+T reduce(T lhs, T rhs, CollReductionOp op)
+{
+  switch (op) {
+    case CollReductionOp::CollSum: return static_cast<T>(lhs + rhs);
+    case CollReductionOp::CollProd: return static_cast<T>(lhs * rhs);
+    case CollReductionOp::CollMin: return std::min(lhs, rhs);
+    case CollReductionOp::CollMax: return std::max(lhs, rhs);
+  }
+  return lhs;
+}
+
+template <>
+bool reduce<bool>(bool lhs, bool rhs, CollReductionOp op)
+{
+  if (op == CollReductionOp::CollSum || op == CollReductionOp::CollMax) return lhs || rhs;
+  return lhs && rhs;
+}
+
+template <>
+__half reduce<__half>(__half lhs, __half rhs, CollReductionOp op)
+{
+  return __half(reduce(static_cast<float>(lhs), static_cast<float>(rhs), op));
+}
+
+template <>
+std::complex<float> reduce<std::complex<float>>(std::complex<float> lhs,
+                                                std::complex<float> rhs,
+                                                CollReductionOp op)
+{
+  return op == CollReductionOp::CollSum ? lhs + rhs : lhs * rhs;
+}
+
+template <>
+std::complex<double> reduce<std::complex<double>>(std::complex<double> lhs,
+                                                  std::complex<double> rhs,
+                                                  CollReductionOp op)
+{
+  return op == CollReductionOp::CollSum ? lhs + rhs : lhs * rhs;
+}
+
+template <typename T>
+bool same(T lhs, T rhs)
+{
+  return lhs == rhs;
+}
+
+template <>
+bool same<__half>(__half lhs, __half rhs)
+{
+  return static_cast<float>(lhs) == static_cast<float>(rhs);
+}
+
+template <typename T>
+double to_double(T value)
+{
+  return static_cast<double>(value);
+}
+
+template <>
+double to_double<__half>(__half value)
+{
+  return static_cast<float>(value);
+}
+
+template <>
+double to_double<std::complex<float>>(std::complex<float> value)
+{
+  return value.real();
+}
+
+template <>
+double to_double<std::complex<double>>(std::complex<double> value)
+{
+  return value.real();
+}
+
+// Reduction over all ranks of the idx-th element of their inputs
+template <typename T>
+T reference(int total_size, int idx, CollReductionOp op)
+{
+  T result = make_value<T>(0, idx, op);
+  for (int rank = 1; rank < total_size; rank++)
+    result = reduce(result, make_value<T>(rank, idx, op), op);
+  return result;
+}
+
+struct Check {
+  const char* collective;
+  const char* type_name;
+  const OpInfo* op;
+  int total_size;
+  int count;
+  int global_rank;
+};
+
+// Compares the received values with the reference, where the first received value is the
+// reduction of the elements at offset `first` of the inputs, and reports the first mismatch
+template <typename T>
+bool verify(const Check& check, const T* recvbuf, int first)
+{
+  for (int i = 0; i < check.count; i++) {
+    T expected = reference<T>(check.total_size, first + i, check.op->op);
+    if (same(recvbuf[i], expected)) continue;
+    fprintf(stderr,
+            "%s of %s with %s over %d ranks, count %d: rank %d has %g at %d, expected %g\n",
+            check.collective,
+            check.type_name,
+            check.op->name,
+            check.total_size,
+            check.count,
+            check.global_rank,
+            to_double(recvbuf[i]),
+            i,
+            to_double(expected));
+    return false;
+  }
+  return true;
+}
+
+template <typename T>
+int check_type(const char* type_name, CollDataType type, int global_rank, CollComm comm)
+{
+  const int total_size = comm->global_comm_size;
+  int failures         = 0;
+  for (const OpInfo& op : OPS) {
+    if (is_complex<T>::value &&
+        (op.op == CollReductionOp::CollMin || op.op == CollReductionOp::CollMax))
+      continue;
+    for (int count : COUNTS) {
+      Check check{nullptr, type_name, &op, total_size, count, global_rank};
+
+      // Not a std::vector, which has no contiguous storage for bool
+      std::unique_ptr<T[]> sendbuf(new T[count * total_size]);
+      for (int i = 0; i < count * total_size; i++)
+        sendbuf[i] = make_value<T>(global_rank, i, op.op);
+
+      std::unique_ptr<T[]> recvbuf(new T[count]);
+      check.collective = "allreduce";
+      if (collAllreduce(sendbuf.get(), recvbuf.get(), count, type, op.op, comm) != CollSuccess ||
+          !verify(check, recvbuf.get(), 0))
+        failures++;
+
+      for (int root : {0, total_size - 1}) {
+        check.collective = "reduce";
+        if (collReduce(sendbuf.get(), recvbuf.get(), count, type, op.op, root, comm) !=
+              CollSuccess ||
+            (global_rank == root && !verify(check, recvbuf.get(), 0)))
+          failures++;
+      }
+
+      check.collective = "reduce_scatter";
+      if (collReduceScatter(sendbuf.get(), recvbuf.get(), count, type, op.op, comm) !=
+            CollSuccess ||
+          !verify(check, recvbuf.get(), global_rank * count))
+        failures++;
+    }
+  }
+  return failures;
+}
+
+struct WorkerArgs {
+  TestState* state;
+  int thread_id;
+};
+
+void* worker(void* arg)
+{
+  WorkerArgs* args = static_cast<WorkerArgs*>(arg);
+  TestState* state = args->state;
+  int nb_threads   = state->nb_threads;
+  int total_size   = nb_threads * state->mpi_comm_size;
+  int global_rank  = state->mpi_rank * nb_threads + args->thread_id;
+
+  Coll_Comm comm;
+#ifdef LEGATE_USE_NETWORK
+  std::vector<int> mapping_table(total_size);
+  for (int i = 0; i < total_size; i++) mapping_table[i] = i / nb_threads;
+  collCommCreate(&comm, total_size, global_rank, state->unique_id, mapping_table.data());
+#else
+  collCommCreate(&comm, total_size, global_rank, state->unique_id, nullptr);
+#endif
+
+  int failures = 0;
+  failures += check_type<bool>("bool", CollDataType::CollBool, global_rank, &comm);
+  failures += check_type<int8_t>("int8", CollDataType::CollInt8, global_rank, &comm);
+  failures += check_type<char>("char", CollDataType::CollChar, global_rank, &comm);
+  failures += check_type<uint8_t>("uint8", CollDataType::CollUint8, global_rank, &comm);
+  failures += check_type<int16_t>("int16", CollDataType::CollInt16, global_rank, &comm);
+  failures += check_type<uint16_t>("uint16", CollDataType::CollUint16, global_rank, &comm);
+  failures += check_type<int32_t>("int32", CollDataType::CollInt, global_rank, &comm);
+  failures += check_type<uint32_t>("uint32", CollDataType::CollUint32, global_rank, &comm);
+  failures += check_type<int64_t>("int64", CollDataType::CollInt64, global_rank, &comm);
+  failures += check_type<uint64_t>("uint64", CollDataType::CollUint64, global_rank, &comm);
+  failures += check_type<__half>("half", CollDataType::CollHalf, global_rank, &comm);
+  failures += check_type<float>("float", CollDataType::CollFloat, global_rank, &comm);
+  failures += check_type<double>("double", CollDataType::CollDouble, global_rank, &comm);
+  failures += check_type<std::complex<float>>(
+    "complex64", CollDataType::CollComplex64, global_rank, &comm);
+  failures += check_type<std::complex<double>>(
+    "complex128", CollDataType::CollComplex128, global_rank, &comm);
+  state->failures += failures;
+
+  collCommDestroy(&comm);
+  return nullptr;
+}
+
+std::vector<int> parse_threads(int argc, char* argv[])
+{
+  std::vector<int> threads;
+  int opt;
+  while ((opt = getopt(argc, argv, "t:h")) != -1) {
+    if (opt != 't') {
+      fprintf(stderr, "Usage: %s [-t threads,...]\n", argv[0]);
+      exit(1);
+    }
+    std::string list(optarg);
+    size_t start = 0;
+    while (start <= list.size()) {
+      size_t end = std::min(list.find(',', start), list.size());
+      if (end > start) threads.push_back(atoi(list.substr(start, end - start).c_str()));
+      start = end + 1;
+    }
+  }
+  if (threads.empty()) threads = {1, 2, 3, 4};
+  for (int nb_threads : threads)
+    if (nb_threads <= 0) {
+      fprintf(stderr, "Invalid thread count %d\n", nb_threads);
+      exit(1);
+    }
+  return threads;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  std::vector<int> threads = parse_threads(argc, argv);
+
+  int mpi_rank = 0, mpi_comm_size = 1;
+#ifdef LEGATE_USE_NETWORK
+  int provided;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+  if (provided != MPI_THREAD_MULTIPLE) {
+    fprintf(stderr, "MPI does not support MPI_THREAD_MULTIPLE\n");
+    MPI_Abort(MPI_COMM_WORLD, 1);
+  }
+  MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &mpi_comm_size);
+#endif
+  collInit(argc, argv);
+
+  int failures = 0;
+  for (int nb_threads : threads) {
+    TestState state;
+    state.nb_threads    = nb_threads;
+    state.mpi_rank      = mpi_rank;
+    state.mpi_comm_size = mpi_comm_size;
+    state.unique_id     = collInitComm();
+
+    std::vector<pthread_t> handles(nb_threads);
+    std::vector<WorkerArgs> args(nb_threads);
+    for (int i = 0; i < nb_threads; i++) {
+      args[i] = WorkerArgs{&state, i};
+      pthread_create(&handles[i], nullptr, worker, &args[i]);
+    }
+    for (int i = 0; i < nb_threads; i++) pthread_join(handles[i], nullptr);
+    failures += state.failures.load();
+  }
+
+#ifdef LEGATE_USE_NETWORK
+  MPI_Allreduce(MPI_IN_PLACE, &failures, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+#endif
+  if (mpi_rank == 0) {
+    if (failures > 0)
+      fprintf(stderr, "%d checks failed\n", failures);
+    else
+      printf("All checks passed\n");
+  }
+
+  collFinalize();
+#ifdef LEGATE_USE_NETWORK
+  MPI_Finalize();
+#endif
+  return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,200 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Checks the MPI tags of the network backend of the CPU collectives.
+//
+// A message is matched on the MPI ranks of its two processes and on its tag, so for every
+// ordered pair of processes, the tags of all (rank1, rank2, collective) triples must be distinct,
+// and they must all lie in [0, MPI_TAG_UB]. The tags are computed for rank layouts with a growing
+// number of ranks per process, up to the largest one whose tags fit in 32767, the smallest upper
+// bound the MPI standard allows. The layouts are described by hand-built communicators, so the
+// program runs in a single process without any communication.
+//
+// Usage: coll_tag_test
+
+#include <assert.h>
+#include <stdio.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "core/comm/coll.h"
+
+using namespace legate::comm::coll;
+
+namespace {
+
+struct TagKind {
+  const char* name;
+  int (*generate)(int rank1, int rank2, CollComm global_comm);
+};
+
+const TagKind TAG_KINDS[] = {
+  {"alltoall", generateAlltoallTag},
+  {"alltoallv", generateAlltoallvTag},
+  {"bcast", generateBcastTag},
+  {"bcast_ring", generateBcastRingTag},
+  {"gather", generateGatherTag},
+  {"allgatherv", generateAllgathervTag},
+  {"allreduce", generateAllreduceTag},
+  {"reduce", generateReduceTag},
+  {"reduce_scatter", generateReduceScatterTag},
+  {"ialltoallv", generateIalltoallvTag},
+  {"iallgather", generateIallgatherTag},
+  {"iallreduce", generateIallreduceTag},
+};
+
+constexpr int NB_TAG_KINDS = sizeof(TAG_KINDS) / sizeof(TAG_KINDS[0]);
+
+// Smallest value of MPI_TAG_UB allowed by the MPI standard
+constexpr int MIN_TAG_UB = 32767;
+
+// Placement of the ranks of a communicator on processes, with the position of each rank within
+// its process that collCommCreate records in the mapping table
+struct Layout {
+  std::string name;
+  std::vector<int> mpi_rank;
+  std::vector<int> local_index;
+  int nb_processes;
+  int nb_threads;
+
+  Layout(const std::string& layout_name, const std::vector<int>& process_of_rank)
+    : name(layout_name), mpi_rank(process_of_rank), local_index(process_of_rank.size())
+  {
+    nb_processes = *std::max_element(mpi_rank.begin(), mpi_rank.end()) + 1;
+    std::vector<int> nb_ranks_of_process(nb_processes, 0);
+    for (size_t i = 0; i < mpi_rank.size(); i++)
+      local_index[i] = nb_ranks_of_process[mpi_rank[i]]++;
+    nb_threads = *std::max_element(nb_ranks_of_process.begin(), nb_ranks_of_process.end());
+  }
+};
+
+// Layouts with at most nb_threads ranks per process: ranks numbered process by process, ranks
+// dealt round-robin to the processes, and processes with different numbers of ranks
+std::vector<Layout> make_layouts(int nb_threads)
+{
+  std::vector<Layout> layouts;
+
+  std::vector<int> contiguous;
+  for (int i = 0; i < 2 * nb_threads; i++) contiguous.push_back(i / nb_threads);
+  layouts.emplace_back("contiguous", contiguous);
+
+  std::vector<int> round_robin;
+  for (int i = 0; i < 2 * nb_threads; i++) round_robin.push_back(i % 2);
+  layouts.emplace_back("round-robin", round_robin);
+
+  std::vector<int> uneven(nb_threads, 0);
+  uneven.insert(uneven.end(), nb_threads - 1, 1);
+  uneven.push_back(2);
+  layouts.emplace_back("uneven", uneven);
+
+  return layouts;
+}
+
+int check_layout(Layout& layout)
+{
+  Coll_Comm global_comm{};
+  global_comm.mapping_table.mpi_rank    = layout.mpi_rank.data();
+  global_comm.mapping_table.local_index = layout.local_index.data();
+  global_comm.global_comm_size          = static_cast<int>(layout.mpi_rank.size());
+  global_comm.mpi_comm_size             = layout.nb_processes;
+  global_comm.nb_threads                = layout.nb_threads;
+
+  CollComm comm    = &global_comm;
+  int64_t max_tag  = generateMaxTag(comm->nb_threads);
+  int size         = comm->global_comm_size;
+  int nb_processes = comm->mpi_comm_size;
+  int failures     = 0;
+
+  // Owner of each tag, as an index into the (rank1, rank2, kind) triples of a pair of processes
+  std::vector<int64_t> owner(max_tag + 1);
+  for (int process1 = 0; process1 < nb_processes; process1++)
+    for (int process2 = 0; process2 < nb_processes; process2++) {
+      std::fill(owner.begin(), owner.end(), -1);
+      for (int rank1 = 0; rank1 < size; rank1++) {
+        if (layout.mpi_rank[rank1] != process1) continue;
+        for (int rank2 = 0; rank2 < size; rank2++) {
+          if (layout.mpi_rank[rank2] != process2) continue;
+          for (int kind = 0; kind < NB_TAG_KINDS; kind++) {
+            int tag        = TAG_KINDS[kind].generate(rank1, rank2, comm);
+            int64_t triple = (static_cast<int64_t>(rank1) * size + rank2) * NB_TAG_KINDS + kind;
+            if (tag < 0 || tag > max_tag) {
+              fprintf(stderr,
+                      "%s layout with %d ranks per process: %s tag of (%d, %d) is %d, "
+                      "outside of [0, %lld]\n",
+                      layout.name.c_str(),
+                      comm->nb_threads,
+                      TAG_KINDS[kind].name,
+                      rank1,
+                      rank2,
+                      tag,
+                      static_cast<long long>(max_tag));
+              failures++;
+              continue;
+            }
+            if (owner[tag] != -1) {
+              int64_t other = owner[tag];
+              fprintf(stderr,
+                      "%s layout with %d ranks per process: %s tag of (%d, %d) is %d, "
+                      "as is the %s tag of (%lld, %lld)\n",
+                      layout.name.c_str(),
+                      comm->nb_threads,
+                      TAG_KINDS[kind].name,
+                      rank1,
+                      rank2,
+                      tag,
+                      TAG_KINDS[other % NB_TAG_KINDS].name,
+                      static_cast<long long>(other / NB_TAG_KINDS / size),
+                      static_cast<long long>(other / NB_TAG_KINDS % size));
+              failures++;
+              continue;
+            }
+            owner[tag] = triple;
+          }
+        }
+      }
+    }
+  return failures;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  int provided;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+  // The tag generators check their tags against the MPI_TAG_UB that collInit reads
+  collInit(argc, argv);
+
+  int *tag_ub, flag;
+  MPI_Comm_get_attr(MPI_COMM_WORLD, MPI_TAG_UB, &tag_ub, &flag);
+  assert(flag);
+  int bound = std::min(*tag_ub, MIN_TAG_UB);
+
+  int failures   = 0;
+  int nb_threads = 1;
+  for (; generateMaxTag(nb_threads) <= bound; nb_threads++)
+    for (auto& layout : make_layouts(nb_threads)) failures += check_layout(layout);
+
+  if (failures > 0)
+    fprintf(stderr, "%d checks failed\n", failures);
+  else
+    printf("Tags are unique up to %d ranks per process\n", nb_threads - 1);
+
+  collFinalize();
+  MPI_Finalize();
+  return failures > 0 ? 1 : 0;
+}
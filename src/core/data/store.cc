@@ -72,25 +72,32 @@ OutputRegionField::OutputRegionField(const OutputRegion& out, FieldID fid)
 }
 
 OutputRegionField::OutputRegionField(OutputRegionField&& other) noexcept
-  : bound_(other.bound_), out_(other.out_), fid_(other.fid_), num_elements_(other.num_elements_)
+  : bound_(other.bound_),
+    num_elements_(other.num_elements_),
+    num_elements_offset_(other.num_elements_offset_),
+    out_(other.out_),
+    fid_(other.fid_)
 {
-  other.bound_        = false;
-  other.out_          = OutputRegion();
-  other.fid_          = -1;
-  other.num_elements_ = UntypedDeferredValue();
+  other.bound_               = false;
+  other.out_                 = OutputRegion();
+  other.fid_                 = -1;
+  other.num_elements_        = UntypedDeferredValue();
+  other.num_elements_offset_ = 0;
 }
 
 OutputRegionField& OutputRegionField::operator=(OutputRegionField&& other) noexcept
 {
-  bound_        = other.bound_;
-  out_          = other.out_;
-  fid_          = other.fid_;
-  num_elements_ = other.num_elements_;
-
-  other.bound_        = false;
-  other.out_          = OutputRegion();
-  other.fid_          = -1;
-  other.num_elements_ = UntypedDeferredValue();
+  bound_               = other.bound_;
+  out_                 = other.out_;
+  fid_                 = other.fid_;
+  num_elements_        = other.num_elements_;
+  num_elements_offset_ = other.num_elements_offset_;
+
+  other.bound_               = false;
+  other.out_                 = OutputRegion();
+  other.fid_                 = -1;
+  other.num_elements_        = UntypedDeferredValue();
+  other.num_elements_offset_ = 0;
 
   return *this;
 }
@@ -119,28 +126,43 @@ ReturnValue OutputRegionField::pack_weight() const
   return ReturnValue(num_elements_, sizeof(size_t));
 }
 
+void OutputRegionField::bind_weight_buffer(const UntypedDeferredValue& buffer, size_t offset)
+{
+  num_elements_        = buffer;
+  num_elements_offset_ = offset;
+}
+
 void OutputRegionField::update_num_elements(size_t num_elements)
 {
-  AccessorWO<size_t, 1> acc(num_elements_, sizeof(size_t), false);
+  AccessorWO<size_t, 1> acc(
+    num_elements_, sizeof(size_t), false, false, nullptr, num_elements_offset_);
   acc[0] = num_elements;
 }
 
-FutureWrapper::FutureWrapper(
-  bool read_only, int32_t field_size, Domain domain, Future future, bool initialize /*= false*/)
-  : read_only_(read_only), field_size_(field_size), domain_(domain), future_(future)
+FutureWrapper::FutureWrapper(bool read_only,
+                             int32_t field_size,
+                             Domain domain,
+                             Future future,
+                             size_t future_offset,
+                             bool initialize /*= false*/)
+  : read_only_(read_only),
+    field_size_(field_size),
+    domain_(domain),
+    future_(future),
+    future_offset_(future_offset)
 {
 #ifdef DEBUG_LEGATE
   assert(field_size > 0);
 #endif
   if (!read_only) {
 #ifdef DEBUG_LEGATE
-    assert(!initialize || future_.get_untyped_size() == field_size);
+    assert(!initialize || future_.get_untyped_size() >= future_offset + field_size);
 #endif
     auto proc     = Processor::get_executing_processor();
     auto mem_kind = proc.kind() == Processor::Kind::TOC_PROC ? Memory::Kind::GPU_FB_MEM
                                                              : Memory::Kind::SYSTEM_MEM;
     if (initialize) {
-      auto p_init_value = future_.get_buffer(mem_kind);
+      auto p_init_value = static_cast<const int8_t*>(future_.get_buffer(mem_kind)) + future_offset;
 #ifdef LEGATE_USE_CUDA
       if (mem_kind == Memory::Kind::GPU_FB_MEM) {
         // TODO: This should be done by Legion
@@ -162,7 +184,9 @@ FutureWrapper::FutureWrapper(const FutureWrapper& other) noexcept
     field_size_(other.field_size_),
     domain_(other.domain_),
     future_(other.future_),
-    buffer_(other.buffer_)
+    future_offset_(other.future_offset_),
+    buffer_(other.buffer_),
+    offset_(other.offset_)
 {
 }
 
@@ -171,8 +195,10 @@ FutureWrapper& FutureWrapper::operator=(const FutureWrapper& other) noexcept
   read_only_  = other.read_only_;
   field_size_ = other.field_size_;
   domain_     = other.domain_;
-  future_     = other.future_;
-  buffer_     = other.buffer_;
+  future_        = other.future_;
+  future_offset_ = other.future_offset_;
+  buffer_        = other.buffer_;
+  offset_        = other.offset_;
   return *this;
 }
 
@@ -180,7 +206,7 @@ Domain FutureWrapper::domain() const { return domain_; }
 
 void FutureWrapper::initialize_with_identity(int32_t redop_id)
 {
-  auto untyped_acc = AccessorWO<int8_t, 1>(buffer_, field_size_);
+  auto untyped_acc = AccessorWO<int8_t, 1>(buffer_, field_size_, false, false, nullptr, offset_);
   auto ptr         = untyped_acc.ptr(0);
 
   auto redop = Runtime::get_reduction_op(redop_id);
@@ -197,7 +223,27 @@ void FutureWrapper::initialize_with_identity(int32_t redop_id)
     memcpy(ptr, identity, field_size_);
 }
 
-ReturnValue FutureWrapper::pack() const { return ReturnValue(buffer_, field_size_); }
+ReturnValue FutureWrapper::pack() const
+{
+#ifdef DEBUG_LEGATE
+  assert(offset_ == 0);
+#endif
+  return ReturnValue(buffer_, field_size_);
+}
+
+void FutureWrapper::bind_return_buffer(const UntypedDeferredValue& buffer, size_t offset)
+{
+#ifdef DEBUG_LEGATE
+  assert(!read_only_);
+  assert(buffer_.get_instance().get_location().kind() != Memory::Kind::GPU_FB_MEM);
+#endif
+  // The value may have been initialized already, e.g., with the identity of the reduction
+  AccessorRO<int8_t, 1> src(buffer_, field_size_, false, false, nullptr, offset_);
+  AccessorWO<int8_t, 1> dst(buffer, field_size_, false, false, nullptr, offset);
+  memcpy(dst.ptr(0), src.ptr(0), field_size_);
+  buffer_ = buffer;
+  offset_ = offset;
+}
 
 Store::Store(int32_t dim,
              int32_t code,
@@ -20,6 +20,7 @@
 #include "core/data/transform.h"
 #include "core/task/return.h"
 #include "core/utilities/machine.h"
+#include "core/utilities/strided_view.h"
 #include "core/utilities/typedefs.h"
 #include "legate_defines.h"
 #include "legion.h"
@@ -186,6 +187,9 @@ class OutputRegionField {
 
  public:
   ReturnValue pack_weight() const;
+  // Makes the store write its number of elements to a slot of the buffer packing the return
+  // values of the task
+  void bind_weight_buffer(const Legion::UntypedDeferredValue& buffer, size_t offset);
 
  private:
   void update_num_elements(size_t num_elements);
@@ -193,6 +197,7 @@ class OutputRegionField {
  private:
   bool bound_{false};
   Legion::UntypedDeferredValue num_elements_;
+  size_t num_elements_offset_{0};
   Legion::OutputRegion out_{};
   Legion::FieldID fid_{-1U};
 };
@@ -204,6 +209,7 @@ class FutureWrapper {
                 int32_t field_size,
                 Legion::Domain domain,
                 Legion::Future future,
+                size_t future_offset,
                 bool initialize = false);
 
  public:
@@ -248,13 +254,19 @@ class FutureWrapper {
 
  public:
   ReturnValue pack() const;
+  // Moves the value to a slot of the buffer packing the return values of the task
+  void bind_return_buffer(const Legion::UntypedDeferredValue& buffer, size_t offset);
 
  private:
   bool read_only_{true};
   size_t field_size_{0};
   Legion::Domain domain_{};
   Legion::Future future_{};
+  // Offset of the value within the future, which can pack the return values of a task
+  size_t future_offset_{0};
   Legion::UntypedDeferredValue buffer_{};
+  // Offset of the value within the buffer
+  size_t offset_{0};
 };
 
 class Store {
@@ -315,6 +327,15 @@ class Store {
   template <typename OP, bool EXCLUSIVE, int32_t DIM>
   AccessorRD<OP, EXCLUSIVE, DIM> reduce_accessor(const Legion::Rect<DIM>& bounds) const;
 
+ public:
+  // Raw views of the elements in the store's shape, for kernels that do their own address
+  // arithmetic. The view is read-only when T is const-qualified. dense_span() requires the
+  // elements to be contiguous in row-major order, which view<T, DIM>().dense() tells.
+  template <typename T, int32_t DIM>
+  StridedView<T, DIM> view() const;
+  template <typename T, int32_t DIM>
+  Span<T> dense_span() const;
+
  public:
   template <typename T, int32_t DIM>
   Buffer<T, DIM> create_output_buffer(const Legion::Point<DIM>& extents,
@@ -344,6 +365,14 @@ class Store {
   bool is_output_store() const { return is_output_store_; }
   ReturnValue pack() const { return future_.pack(); }
   ReturnValue pack_weight() const { return output_field_.pack_weight(); }
+  void bind_return_buffer(const Legion::UntypedDeferredValue& buffer, size_t offset)
+  {
+    future_.bind_return_buffer(buffer, offset);
+  }
+  void bind_weight_buffer(const Legion::UntypedDeferredValue& buffer, size_t offset)
+  {
+    output_field_.bind_weight_buffer(buffer, offset);
+  }
 
  public:
   // TODO: It'd be btter to return a parent store from this method than permanently
@@ -148,9 +148,9 @@ AccessorRO<T, DIM> FutureWrapper::read_accessor() const
 #endif
   if (read_only_) {
     auto memkind = Legion::Memory::Kind::NO_MEMKIND;
-    return AccessorRO<T, DIM>(future_, memkind);
+    return AccessorRO<T, DIM>(future_, memkind, sizeof(T), false, false, nullptr, future_offset_);
   } else
-    return AccessorRO<T, DIM>(buffer_);
+    return AccessorRO<T, DIM>(buffer_, sizeof(T), false, false, nullptr, offset_);
 }
 
 template <typename T, int DIM>
@@ -160,7 +160,7 @@ AccessorWO<T, DIM> FutureWrapper::write_accessor() const
   assert(sizeof(T) == field_size_);
   assert(!read_only_);
 #endif
-  return AccessorWO<T, DIM>(buffer_);
+  return AccessorWO<T, DIM>(buffer_, sizeof(T), false, false, nullptr, offset_);
 }
 
 template <typename T, int DIM>
@@ -170,7 +170,7 @@ AccessorRW<T, DIM> FutureWrapper::read_write_accessor() const
   assert(sizeof(T) == field_size_);
   assert(!read_only_);
 #endif
-  return AccessorRW<T, DIM>(buffer_);
+  return AccessorRW<T, DIM>(buffer_, sizeof(T), false, false, nullptr, offset_);
 }
 
 template <typename OP, bool EXCLUSIVE, int DIM>
@@ -180,7 +180,7 @@ AccessorRD<OP, EXCLUSIVE, DIM> FutureWrapper::reduce_accessor(int32_t redop_id)
   assert(sizeof(typename OP::LHS) == field_size_);
   assert(!read_only_);
 #endif
-  return AccessorRD<OP, EXCLUSIVE, DIM>(buffer_);
+  return AccessorRD<OP, EXCLUSIVE, DIM>(buffer_, false, nullptr, offset_);
 }
 
 template <typename T, int DIM>
@@ -191,9 +191,10 @@ AccessorRO<T, DIM> FutureWrapper::read_accessor(const Legion::Rect<DIM>& bounds)
 #endif
   if (read_only_) {
     auto memkind = Legion::Memory::Kind::NO_MEMKIND;
-    return AccessorRO<T, DIM>(future_, bounds, memkind);
+    return AccessorRO<T, DIM>(
+      future_, bounds, memkind, sizeof(T), false, false, nullptr, future_offset_);
   } else
-    return AccessorRO<T, DIM>(buffer_, bounds);
+    return AccessorRO<T, DIM>(buffer_, bounds, sizeof(T), false, false, nullptr, offset_);
 }
 
 template <typename T, int DIM>
@@ -203,7 +204,7 @@ AccessorWO<T, DIM> FutureWrapper::write_accessor(const Legion::Rect<DIM>& bounds
   assert(sizeof(T) == field_size_);
   assert(!read_only_);
 #endif
-  return AccessorWO<T, DIM>(buffer_, bounds);
+  return AccessorWO<T, DIM>(buffer_, bounds, sizeof(T), false, false, nullptr, offset_);
 }
 
 template <typename T, int DIM>
@@ -213,7 +214,7 @@ AccessorRW<T, DIM> FutureWrapper::read_write_accessor(const Legion::Rect<DIM>& b
   assert(sizeof(T) == field_size_);
   assert(!read_only_);
 #endif
-  return AccessorRW<T, DIM>(buffer_, bounds);
+  return AccessorRW<T, DIM>(buffer_, bounds, sizeof(T), false, false, nullptr, offset_);
 }
 
 template <typename OP, bool EXCLUSIVE, int DIM>
@@ -224,7 +225,7 @@ AccessorRD<OP, EXCLUSIVE, DIM> FutureWrapper::reduce_accessor(int32_t redop_id,
   assert(sizeof(typename OP::LHS) == field_size_);
   assert(!read_only_);
 #endif
-  return AccessorRD<OP, EXCLUSIVE, DIM>(buffer_, bounds);
+  return AccessorRD<OP, EXCLUSIVE, DIM>(buffer_, bounds, false, nullptr, offset_);
 }
 
 template <int32_t DIM>
@@ -240,9 +241,11 @@ VAL FutureWrapper::scalar() const
   assert(sizeof(VAL) == field_size_);
 #endif
   if (!read_only_)
-    return buffer_.operator Legion::DeferredValue<VAL>().read();
-  else
-    return future_.get_result<VAL>();
+    return AccessorRO<VAL, 1>(buffer_, sizeof(VAL), false, false, nullptr, offset_)[0];
+  else {
+    auto ptr = static_cast<const int8_t*>(future_.get_buffer(Legion::Memory::Kind::SYSTEM_MEM));
+    return *reinterpret_cast<const VAL*>(ptr + future_offset_);
+  }
 }
 
 template <typename T, int32_t DIM>
@@ -400,6 +403,42 @@ AccessorRD<OP, EXCLUSIVE, DIM> Store::reduce_accessor(const Legion::Rect<DIM>& b
   return region_field_.reduce_accessor<OP, EXCLUSIVE, DIM>(redop_id_, bounds);
 }
 
+template <typename T, int32_t DIM>
+StridedView<T, DIM> Store::view() const
+{
+  using VAL = std::remove_const_t<T>;
+
+  auto shape = this->shape<DIM>();
+  size_t strides[DIM];
+  if (shape.empty()) {
+    for (int32_t dim = 0; dim < DIM; ++dim) strides[dim] = 0;
+    return StridedView<T, DIM>(nullptr, shape, strides);
+  }
+
+  // The pointers of writable views come from write accessors, which are valid on both
+  // read-write and write-discard stores
+  if constexpr (std::is_const<T>::value) {
+    auto acc = read_accessor<VAL, DIM>(shape);
+    T* ptr   = acc.ptr(shape, strides);
+    return StridedView<T, DIM>(ptr, shape, strides);
+  } else {
+    auto acc = write_accessor<VAL, DIM>(shape);
+    T* ptr   = acc.ptr(shape, strides);
+    return StridedView<T, DIM>(ptr, shape, strides);
+  }
+}
+
+template <typename T, int32_t DIM>
+Span<T> Store::dense_span() const
+{
+  auto view = this->view<T, DIM>();
+  if (!view.dense()) {
+    log_legate.error("Invalid to take a dense span of a store whose elements are not contiguous");
+    LEGATE_ABORT;
+  }
+  return view.dense_span();
+}
+
 template <typename T, int32_t DIM>
 Buffer<T, DIM> Store::create_output_buffer(const Legion::Point<DIM>& extents,
                                            bool return_buffer /*= false*/)
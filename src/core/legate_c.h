@@ -25,6 +25,7 @@
 
 typedef enum legate_core_task_id_t {
   LEGATE_CORE_EXTRACT_SCALAR_TASK_ID,
+  LEGATE_CORE_FETCH_ERROR_MESSAGE_TASK_ID,
   LEGATE_CORE_INIT_NCCL_ID_TASK_ID,
   LEGATE_CORE_INIT_NCCL_TASK_ID,
   LEGATE_CORE_FINALIZE_NCCL_TASK_ID,
@@ -106,11 +107,45 @@ typedef enum legate_core_mapping_tag_t {
   LEGATE_CORE_JOIN_EXCEPTION_TAG         = 4,
 } legate_core_mapping_tag_t;
 
+typedef enum legate_core_semantic_tag_t {
+  // Layout constraints that a task declares on its store arguments
+  LEGATE_CORE_STORE_LAYOUTS_SEMANTIC_TAG = 1000,
+} legate_core_semantic_tag_t;
+
 typedef enum legate_core_reduction_op_id_t {
   LEGATE_CORE_JOIN_EXCEPTION_OP   = 0,
   LEGATE_CORE_MAX_REDUCTION_OP_ID = 1,
 } legate_core_reduction_op_id_t;
 
+typedef enum legate_cpucoll_kind_t {
+  LEGATE_CPUCOLL_ALLTOALLV      = 0,
+  LEGATE_CPUCOLL_ALLTOALL       = 1,
+  LEGATE_CPUCOLL_ALLGATHER      = 2,
+  LEGATE_CPUCOLL_BCAST          = 3,
+  LEGATE_CPUCOLL_GATHER         = 4,
+  LEGATE_CPUCOLL_ALLREDUCE      = 5,
+  LEGATE_CPUCOLL_REDUCE         = 6,
+  LEGATE_CPUCOLL_REDUCE_SCATTER = 7,
+  LEGATE_CPUCOLL_IALLTOALLV     = 8,
+  LEGATE_CPUCOLL_IALLGATHER     = 9,
+  LEGATE_CPUCOLL_IALLREDUCE     = 10,
+  LEGATE_CPUCOLL_ALLGATHERV     = 11,
+  LEGATE_CPUCOLL_NUM_KINDS      = 12,
+} legate_cpucoll_kind_t;
+
+// Telemetry of one kind of CPU collective, summed over the ranks of a process
+typedef struct legate_cpucoll_stats_t {
+  uint64_t calls;
+  uint64_t bytes_sent;
+  uint64_t bytes_received;
+  // Seconds spent in the collectives, and the part of it spent blocked on ranks of the same
+  // process
+  double time;
+  double wait_time;
+  // Longest a rank was blocked on other ranks in a single call
+  double max_skew;
+} legate_cpucoll_stats_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -132,6 +167,9 @@ void legate_cpucoll_finalize(void);
 
 int legate_cpucoll_initcomm(void);
 
+// Returns 0 when telemetry is disabled, that is, unless LEGATE_COLL_STATS is set
+int legate_cpucoll_get_stats(legate_cpucoll_kind_t kind, legate_cpucoll_stats_t* stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -14,6 +14,7 @@
  *
  */
 
+#include <algorithm>
 #include <cstdlib>
 #include <sstream>
 
@@ -497,6 +498,26 @@ VariantID BaseMapper::find_variant(const MapperContext ctx,
   return result;
 }
 
+const TaskLayoutConstraints& BaseMapper::find_store_layouts(const MapperContext ctx,
+                                                            TaskID task_id)
+{
+  auto finder = store_layouts.find(task_id);
+  if (finder != store_layouts.end()) return finder->second;
+  // Tasks that declare no layout constraints have no semantic information under the tag
+  const void* buffer = nullptr;
+  size_t size        = 0;
+  if (runtime->retrieve_semantic_information(ctx,
+                                             task_id,
+                                             LEGATE_CORE_STORE_LAYOUTS_SEMANTIC_TAG,
+                                             buffer,
+                                             size,
+                                             true /*can_fail*/,
+                                             false /*wait_until_ready*/))
+    return store_layouts[task_id] = TaskLayoutConstraints(buffer, size);
+  else
+    return store_layouts[task_id];
+}
+
 void BaseMapper::map_task(const MapperContext ctx,
                           const LegionTask& task,
                           const MapTaskInput& input,
@@ -577,27 +598,52 @@ void BaseMapper::map_task(const MapperContext ctx,
     }
   }
 
-  // Generate default mappings for stores that are not yet mapped by the client mapper
+  // Generate default mappings for stores that are not yet mapped by the client mapper,
+  // following the layouts that the task declared for them
+  auto& task_layouts       = find_store_layouts(ctx, task.task_id);
+  auto num_client_mappings = mappings.size();
+  auto apply_store_layout  = [&](InstanceMappingPolicy& policy, auto kind, uint32_t idx) {
+    auto constraint = task_layouts.find(kind, idx);
+    if (nullptr == constraint) return;
+    switch (constraint->ordering) {
+      case StoreLayoutConstraint::Ordering::C: policy.ordering.c_order(); break;
+      case StoreLayoutConstraint::Ordering::FORTRAN: policy.ordering.fortran_order(); break;
+      case StoreLayoutConstraint::Ordering::ANY: break;
+    }
+    policy.exact     = policy.exact || constraint->exact;
+    policy.alignment = std::max(policy.alignment, constraint->alignment);
+  };
+
   auto default_option            = options.front();
-  auto generate_default_mappings = [&](auto& stores, bool exact) {
-    for (auto& store : stores) {
+  auto generate_default_mappings = [&](auto& stores, auto kind, bool exact) {
+    for (uint32_t idx = 0; idx < stores.size(); ++idx) {
+      auto& store = stores[idx];
       if (store.is_future()) {
         auto fut_idx = store.future().index();
         if (client_mapped_futures.find(fut_idx) == client_mapped_futures.end())
           mappings.push_back(StoreMapping::default_mapping(store, default_option, exact));
         continue;
       } else {
-        auto key = store.region_field().unique_id();
-        if (client_mapped_regions.find(key) != client_mapped_regions.end()) continue;
+        auto key    = store.region_field().unique_id();
+        auto finder = client_mapped_regions.find(key);
+        if (finder != client_mapped_regions.end()) {
+          // A store that shares its default mapping with an earlier argument adds its own
+          // layout to the mapping
+          if (finder->second >= num_client_mappings)
+            apply_store_layout(mappings[finder->second].policy, kind, idx);
+          continue;
+        }
         client_mapped_regions[key] = static_cast<int32_t>(mappings.size());
         mappings.push_back(StoreMapping::default_mapping(store, default_option, exact));
+        apply_store_layout(mappings.back().policy, kind, idx);
       }
     }
   };
 
-  generate_default_mappings(legate_task.inputs(), false);
-  generate_default_mappings(legate_task.outputs(), false);
-  generate_default_mappings(legate_task.reductions(), false);
+  generate_default_mappings(legate_task.inputs(), StoreLayoutConstraint::ArgKind::INPUT, false);
+  generate_default_mappings(legate_task.outputs(), StoreLayoutConstraint::ArgKind::OUTPUT, false);
+  generate_default_mappings(
+    legate_task.reductions(), StoreLayoutConstraint::ArgKind::REDUCTION, false);
 
   output.chosen_instances.resize(task.regions.size());
 
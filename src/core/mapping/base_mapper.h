@@ -24,6 +24,7 @@
 #include "core/data/scalar.h"
 #include "core/mapping/mapping.h"
 #include "core/runtime/context.h"
+#include "core/task/layout.h"
 #include "core/utilities/typedefs.h"
 
 namespace legate {
@@ -299,6 +300,8 @@ class BaseMapper : public Legion::Mapping::Mapper, public LegateMapper {
   Legion::VariantID find_variant(const Legion::Mapping::MapperContext ctx,
                                  const Legion::Task& task,
                                  Legion::Processor::Kind kind);
+  const TaskLayoutConstraints& find_store_layouts(const Legion::Mapping::MapperContext ctx,
+                                                  Legion::TaskID task_id);
 
  private:
   void generate_prime_factors();
@@ -351,6 +354,7 @@ class BaseMapper : public Legion::Mapping::Mapper, public LegateMapper {
 
  protected:
   std::map<std::pair<Legion::TaskID, Legion::Processor::Kind>, Legion::VariantID> leaf_variants;
+  std::map<Legion::TaskID, TaskLayoutConstraints> store_layouts;
 
  protected:
   InstanceManager* local_instances;
@@ -71,6 +71,10 @@ class CoreMapper : public Legion::Mapping::NullMapper {
                         const Task& task,
                         const MapTaskInput& input,
                         MapTaskOutput& output);
+  virtual void select_task_sources(const MapperContext ctx,
+                                   const Task& task,
+                                   const SelectTaskSrcInput& input,
+                                   SelectTaskSrcOutput& output);
   virtual void select_sharding_functor(const MapperContext ctx,
                                        const Task& task,
                                        const SelectShardingFunctorInput& input,
@@ -236,6 +240,18 @@ Mapper::MapperSyncModel CoreMapper::get_mapper_sync_model(void) const
 void CoreMapper::select_task_options(const MapperContext ctx, const Task& task, TaskOptions& output)
 {
   assert(context.valid_task_id(task.task_id));
+  // An error message is fetched from the node that keeps it, which the launch passes as its point
+  if (context.get_local_task_id(task.task_id) == LEGATE_CORE_FETCH_ERROR_MESSAGE_TASK_ID) {
+    const AddressSpace node = task.index_point[0];
+    Machine::ProcessorQuery all_cpus(machine);
+    all_cpus.only_kind(Processor::LOC_PROC);
+    for (auto it = all_cpus.begin(); it != all_cpus.end(); it++)
+      if (it->address_space() == node) {
+        output.initial_proc = *it;
+        return;
+      }
+    assert(false);
+  }
   if (task.tag == LEGATE_CPU_VARIANT) {
     assert(!local_cpus.empty());
     output.initial_proc = local_cpus.front();
@@ -329,6 +345,55 @@ void CoreMapper::map_task(const MapperContext ctx,
   // Just put our target proc in the target processors for now
   output.target_procs.push_back(task.target_proc);
   output.chosen_variant = task.tag;
+
+  // The only core tasks with region arguments are the ones creating CPU communicators, which
+  // pass the mapping table through a small store. Map it to the memory of the target processor.
+  if (task.regions.empty()) return;
+  Memory target_memory = local_system_memory;
+  if (task.target_proc.kind() == Processor::OMP_PROC)
+    target_memory = local_numa_domains[task.target_proc];
+
+  for (uint32_t idx = 0; idx < task.regions.size(); ++idx) {
+    const RegionRequirement& req = task.regions[idx];
+    if (req.privilege_fields.empty()) continue;
+
+    LayoutConstraintSet layout_constraints;
+    // No specialization
+    layout_constraints.add_constraint(SpecializedConstraint());
+    // SOA-C dimension ordering
+    std::vector<DimensionKind> dimension_ordering(4);
+    dimension_ordering[0] = DIM_Z;
+    dimension_ordering[1] = DIM_Y;
+    dimension_ordering[2] = DIM_X;
+    dimension_ordering[3] = DIM_F;
+    layout_constraints.add_constraint(OrderingConstraint(dimension_ordering, false /*contiguous*/));
+    // Constraint for the kind of memory
+    layout_constraints.add_constraint(MemoryConstraint(target_memory.kind()));
+    const std::vector<FieldID> fields(req.privilege_fields.begin(), req.privilege_fields.end());
+    layout_constraints.add_constraint(FieldConstraint(fields, true /*contiguous*/));
+
+    const std::vector<LogicalRegion> regions(1, req.region);
+    PhysicalInstance instance;
+    bool created;
+    if (!runtime->find_or_create_physical_instance(
+          ctx, target_memory, layout_constraints, regions, instance, created, true /*acquire*/))
+      LEGATE_ABORT;
+    output.chosen_instances[idx].push_back(instance);
+  }
+}
+
+void CoreMapper::select_task_sources(const MapperContext ctx,
+                                     const Task& task,
+                                     const SelectTaskSrcInput& input,
+                                     SelectTaskSrcOutput& output)
+{
+  // Copy from the instances on this node first
+  for (auto& instance : input.source_instances)
+    if (instance.get_location().address_space() == local_node)
+      output.chosen_ranking.push_back(instance);
+  for (auto& instance : input.source_instances)
+    if (instance.get_location().address_space() != local_node)
+      output.chosen_ranking.push_back(instance);
 }
 
 void CoreMapper::select_sharding_functor(const MapperContext ctx,
@@ -337,7 +402,6 @@ void CoreMapper::select_sharding_functor(const MapperContext ctx,
                                          SelectShardingFunctorOutput& output)
 {
   assert(context.valid_task_id(task.task_id));
-  assert(task.regions.empty());
   const int launch_dim = task.index_domain.get_dim();
   assert(launch_dim == 1);
   output.chosen_functor = context.get_sharding_id(LEGATE_CORE_TOPLEVEL_TASK_SHARD_ID);
@@ -377,15 +441,13 @@ void CoreMapper::map_future_map_reduction(const MapperContext ctx,
                                           const FutureMapReductionInput& input,
                                           FutureMapReductionOutput& output)
 {
-  output.serdez_upper_bound = LEGATE_MAX_SIZE_SCALAR_RETURN;
-
 #ifdef LEGATE_MAP_FUTURE_MAP_REDUCTIONS_TO_GPU
   // TODO: It's been reported that blindly mapping target instances of future map reductions
   // to framebuffers hurts performance. Until we find a better mapping policy, we guard
   // the current policy with a macro.
 
   // If this was joining exceptions, we don't want to put instances anywhere
-  // other than the system memory because they need serdez
+  // other than the system memory because the join is only implemented on CPUs
   if (input.tag == LEGATE_CORE_JOIN_EXCEPTION_TAG) return;
   if (!local_gpus.empty())
     for (auto& pair : local_frame_buffers) output.destination_memories.push_back(pair.second);
@@ -81,7 +81,7 @@ void DimOrdering::custom_order(std::vector<int32_t>&& dims)
 bool InstanceMappingPolicy::operator==(const InstanceMappingPolicy& other) const
 {
   return target == other.target && allocation == other.allocation && layout == other.layout &&
-         exact == other.exact && ordering == other.ordering;
+         exact == other.exact && ordering == other.ordering && alignment == other.alignment;
 }
 
 bool InstanceMappingPolicy::operator!=(const InstanceMappingPolicy& other) const
@@ -159,6 +159,11 @@ void StoreMapping::populate_layout_constraints(
   } else
     fields.push_back(stores.front().region_field().field_id());
   layout_constraints.add_constraint(FieldConstraint(fields, true /*contiguous*/));
+
+  if (policy.alignment > 0)
+    for (auto field_id : fields)
+      layout_constraints.add_constraint(
+        AlignmentConstraint(field_id, LEGION_GE_EK, policy.alignment));
 }
 
 /*static*/ StoreMapping StoreMapping::default_mapping(const Store& store,
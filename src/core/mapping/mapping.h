@@ -92,6 +92,8 @@ struct InstanceMappingPolicy {
   InstLayout layout{InstLayout::SOA};
   DimOrdering ordering{};
   bool exact{false};
+  // Minimum alignment of the instance in bytes; 0 leaves it to the runtime
+  uint32_t alignment{0};
 
  public:
   InstanceMappingPolicy() {}
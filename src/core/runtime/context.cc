@@ -23,6 +23,8 @@
 #include "core/runtime/context.h"
 #include "core/runtime/runtime.h"
 #include "core/utilities/deserializer.h"
+#include "core/utilities/linearize.h"
+#include "core/utilities/machine.h"
 
 #ifdef LEGATE_USE_CUDA
 #include "core/cuda/cuda_help.h"
@@ -163,13 +165,14 @@ TaskContext::TaskContext(const Legion::Task* task,
                          Legion::Runtime* runtime)
   : task_(task), regions_(regions), context_(context), runtime_(runtime)
 {
-  TaskDeserializer dez(task, regions);
+  TaskDeserializer dez(task, regions, &arena_);
   inputs_     = dez.unpack<std::vector<Store>>();
   outputs_    = dez.unpack<std::vector<Store>>();
   reductions_ = dez.unpack<std::vector<Store>>();
   scalars_    = dez.unpack<std::vector<Scalar>>();
 
   can_raise_exception_ = dez.unpack<bool>();
+  if (can_raise_exception_) exception_id_ = dez.unpack<uint64_t>();
 
   bool insert_barrier = false;
   Legion::PhaseBarrier arrival, wait;
@@ -186,11 +189,16 @@ TaskContext::TaskContext(const Legion::Task* task,
   // To simplify the programming mode, we filter out those "invalid" stores out.
   if (task_->tag == LEGATE_CORE_TREE_REDUCE_TAG) {
     std::vector<Store> inputs;
+    inputs.reserve(inputs_.size());
     for (auto& input : inputs_)
       if (input.valid()) inputs.push_back(std::move(input));
     inputs_.swap(inputs);
   }
 
+  // Tasks running on GPUs keep their return values in framebuffers and pack them at the end
+  if (Legion::Processor::get_executing_processor().kind() != Legion::Processor::Kind::TOC_PROC)
+    layout_return_values();
+
   // CUDA drivers < 520 have a bug that causes deadlock under certain circumstances
   // if the application has multiple threads that launch blocking kernels, such as
   // NCCL all-reduce kernels. This barrier prevents such deadlock by making sure
@@ -226,25 +234,71 @@ void TaskContext::make_all_unbound_stores_empty()
 
 ReturnValues TaskContext::pack_return_values() const
 {
-  auto return_values = get_return_values();
-  if (can_raise_exception_) {
-    ReturnedException exn{};
-    return_values.push_back(exn.pack());
+  if (return_values_.in_place()) {
+#ifdef DEBUG_LEGATE
+    // The weights are already in the packed buffer, but packing them checks that every unbound
+    // store was bound to a buffer
+    for (auto& output : outputs_)
+      if (output.is_output_store()) output.pack_weight();
+#endif
+    return return_values_;
   }
+
+  auto return_values = get_return_values();
+  if (can_raise_exception_) return_values.push_back(ReturnedException().pack());
   return ReturnValues(std::move(return_values));
 }
 
 ReturnValues TaskContext::pack_return_values_with_exception(int32_t index,
                                                             const std::string& error_message) const
 {
-  auto return_values = get_return_values();
-  if (can_raise_exception_) {
-    ReturnedException exn(index, error_message);
-    return_values.push_back(exn.pack());
+  if (!can_raise_exception_) return pack_return_values();
+
+  int64_t point = 0;
+  if (!is_single_task())
+    point = linearize(task_->index_domain.lo(), task_->index_domain.hi(), task_->index_point);
+  ReturnedException exn(index, point);
+  record_error_message(exception_id_, point, error_message);
+
+  // The status goes to the slot reserved for it, as the last return value
+  if (return_values_.in_place()) {
+    auto num_values = static_cast<int32_t>(return_values_.size());
+    *static_cast<ExceptionStatus*>(return_values_.slot(num_values - 1)) = exn.status();
+    return return_values_;
   }
+  auto return_values = get_return_values();
+  return_values.push_back(exn.pack());
   return ReturnValues(std::move(return_values));
 }
 
+void TaskContext::layout_return_values()
+{
+  // The slots follow the order of get_return_values
+  std::vector<size_t> sizes;
+  for (auto& output : outputs_)
+    if (output.is_output_store()) sizes.push_back(sizeof(size_t));
+  for (auto& output : outputs_)
+    if (output.is_future()) sizes.push_back(output.pack().second);
+  for (auto& reduction : reductions_)
+    if (reduction.is_future()) sizes.push_back(reduction.pack().second);
+  if (can_raise_exception_) sizes.push_back(sizeof(ExceptionStatus));
+
+  // A single return value is handed off in the buffer that holds it
+  if (sizes.size() < 2) return;
+
+  return_values_ = ReturnValues(sizes, find_memory_kind_for_executing_processor());
+
+  auto& buffer = return_values_.buffer();
+  int32_t idx  = 0;
+  for (auto& output : outputs_)
+    if (output.is_output_store()) output.bind_weight_buffer(buffer, return_values_.offset(idx++));
+  for (auto& output : outputs_)
+    if (output.is_future()) output.bind_return_buffer(buffer, return_values_.offset(idx++));
+  for (auto& reduction : reductions_)
+    if (reduction.is_future()) reduction.bind_return_buffer(buffer, return_values_.offset(idx++));
+  if (can_raise_exception_) new (return_values_.slot(idx)) ExceptionStatus{};
+}
+
 std::vector<ReturnValue> TaskContext::get_return_values() const
 {
   size_t num_unbound_outputs = 0;
@@ -20,6 +20,7 @@
 
 #include "core/comm/communicator.h"
 #include "core/task/return.h"
+#include "core/utilities/arena.h"
 
 namespace legate {
 
@@ -116,6 +117,10 @@ class LibraryContext {
 
 // A thin context layer on top of the Legion runtime, primarily designed to hide verbosity
 // of the Legion API.
+//
+// The transform stacks of the stores are allocated from an arena owned by the context, so the
+// stores must not outlive the task that received them. Builds with DEBUG_LEGATE abort when a
+// store does.
 class TaskContext {
  public:
   TaskContext(const Legion::Task* task,
@@ -143,6 +148,7 @@ class TaskContext {
                                                  const std::string& error_message) const;
 
  private:
+  void layout_return_values();
   std::vector<ReturnValue> get_return_values() const;
 
  private:
@@ -150,12 +156,18 @@ class TaskContext {
   const std::vector<Legion::PhysicalRegion>& regions_;
   Legion::Context context_;
   Legion::Runtime* runtime_;
+  // Declared ahead of the stores so that it outlives them
+  TaskArena arena_;
 
  private:
   std::vector<Store> inputs_, outputs_, reductions_;
   std::vector<Scalar> scalars_;
   std::vector<comm::Communicator> comms_;
   bool can_raise_exception_;
+  // Identifies the launch in the error messages that the points leave on their nodes
+  uint64_t exception_id_{0};
+  // Buffer to which the stores write the return values in place, if the task has several
+  ReturnValues return_values_;
 };
 
 }  // namespace legate
@@ -22,6 +22,7 @@
 #include "core/task/exception.h"
 #include "core/task/task.h"
 #include "core/utilities/deserializer.h"
+#include "core/utilities/nvtx_help.h"
 #include "legate.h"
 
 namespace legate {
@@ -80,6 +81,14 @@ static const char* const core_library_name = "legate.core";
   parse_variable("LEGATE_EMPTY_TASK", use_empty_task);
   parse_variable("LEGATE_SYNC_STREAM_VIEW", synchronize_stream_view);
   parse_variable("LEGATE_LOG_MAPPING", log_mapping_decisions);
+
+  bool collect_task_stats = false;
+  parse_variable("LEGATE_TASK_STATS", collect_task_stats);
+  if (collect_task_stats) TaskTimer::enable();
+
+  bool trace_ranges = false;
+  parse_variable("LEGATE_TRACE_RANGES", trace_ranges);
+  if (trace_ranges) nvtx::Range::enable_tracing();
 }
 
 static void extract_scalar_task(
@@ -102,6 +111,26 @@ static void extract_scalar_task(
   ReturnValues({values[idx]}).finalize(legion_context);
 }
 
+static void fetch_error_message_task(
+  const void* args, size_t arglen, const void* userdata, size_t userlen, Legion::Processor p)
+{
+  // Legion preamble
+  const Legion::Task* task;
+  const std::vector<Legion::PhysicalRegion>* regions;
+  Legion::Context legion_context;
+  Legion::Runtime* runtime;
+  Legion::Runtime::legion_task_preamble(args, arglen, p, task, regions, legion_context, runtime);
+
+  Core::show_progress(task, legion_context, runtime, task->get_task_name());
+
+  TaskContext context(task, *regions, legion_context, runtime);
+  auto exception_id = context.scalars()[0].value<uint64_t>();
+  auto point        = context.scalars()[1].value<int64_t>();
+
+  // Legion postamble
+  ReturnValues({fetch_error_message(exception_id, point)}).finalize(legion_context);
+}
+
 /*static*/ void Core::shutdown(void)
 {
   // Nothing to do here yet...
@@ -149,6 +178,14 @@ void register_legate_core_tasks(Machine machine, Runtime* runtime, const Library
   runtime->attach_name(
     extract_scalar_task_id, extract_scalar_task_name, false /*mutable*/, true /*local only*/);
 
+  const TaskID fetch_error_message_task_id =
+    context.get_task_id(LEGATE_CORE_FETCH_ERROR_MESSAGE_TASK_ID);
+  const char* fetch_error_message_task_name = "core::fetch_error_message";
+  runtime->attach_name(fetch_error_message_task_id,
+                       fetch_error_message_task_name,
+                       false /*mutable*/,
+                       true /*local only*/);
+
   auto make_registrar = [&](auto task_id, auto* task_name, auto proc_kind) {
     TaskVariantRegistrar registrar(task_id, task_name);
     registrar.add_constraint(ProcessorConstraint(proc_kind));
@@ -162,8 +199,25 @@ void register_legate_core_tasks(Machine machine, Runtime* runtime, const Library
     auto registrar =
       make_registrar(extract_scalar_task_id, extract_scalar_task_name, Processor::LOC_PROC);
     Legion::CodeDescriptor desc(extract_scalar_task);
-    runtime->register_task_variant(
-      registrar, desc, nullptr, 0, LEGATE_MAX_SIZE_SCALAR_RETURN, LEGATE_CPU_VARIANT);
+    runtime->register_task_variant(registrar,
+                                   desc,
+                                   nullptr,
+                                   0,
+                                   0 /*return_type_size*/,
+                                   LEGATE_CPU_VARIANT,
+                                   false /*has_return_type_size*/);
+  }
+  {
+    auto registrar = make_registrar(
+      fetch_error_message_task_id, fetch_error_message_task_name, Processor::LOC_PROC);
+    Legion::CodeDescriptor desc(fetch_error_message_task);
+    runtime->register_task_variant(registrar,
+                                   desc,
+                                   nullptr,
+                                   0,
+                                   0 /*return_type_size*/,
+                                   LEGATE_CPU_VARIANT,
+                                   false /*has_return_type_size*/);
   }
   comm::register_tasks(machine, runtime, context);
 }
@@ -0,0 +1,92 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cassert>
+#include <cstring>
+
+#include "core/task/layout.h"
+
+namespace legate {
+
+StoreLayoutConstraint& StoreLayoutConstraint::c_order()
+{
+  ordering = Ordering::C;
+  return *this;
+}
+
+StoreLayoutConstraint& StoreLayoutConstraint::fortran_order()
+{
+  ordering = Ordering::FORTRAN;
+  return *this;
+}
+
+StoreLayoutConstraint& StoreLayoutConstraint::contiguous()
+{
+  exact = true;
+  return *this;
+}
+
+StoreLayoutConstraint& StoreLayoutConstraint::align(uint32_t bytes)
+{
+  // Legion only supports power-of-two alignments
+  assert(bytes > 0 && (bytes & (bytes - 1)) == 0);
+  alignment = bytes;
+  return *this;
+}
+
+TaskLayoutConstraints::TaskLayoutConstraints(const void* buffer, size_t size)
+{
+  assert(size % sizeof(StoreLayoutConstraint) == 0);
+  constraints_.resize(size / sizeof(StoreLayoutConstraint));
+  memcpy(constraints_.data(), buffer, size);
+}
+
+StoreLayoutConstraint& TaskLayoutConstraints::input(uint32_t index)
+{
+  return get(StoreLayoutConstraint::ArgKind::INPUT, index);
+}
+
+StoreLayoutConstraint& TaskLayoutConstraints::output(uint32_t index)
+{
+  return get(StoreLayoutConstraint::ArgKind::OUTPUT, index);
+}
+
+StoreLayoutConstraint& TaskLayoutConstraints::reduction(uint32_t index)
+{
+  return get(StoreLayoutConstraint::ArgKind::REDUCTION, index);
+}
+
+const StoreLayoutConstraint* TaskLayoutConstraints::find(StoreLayoutConstraint::ArgKind kind,
+                                                         uint32_t index) const
+{
+  for (auto& constraint : constraints_)
+    if (constraint.kind == kind && constraint.index == index) return &constraint;
+  return nullptr;
+}
+
+StoreLayoutConstraint& TaskLayoutConstraints::get(StoreLayoutConstraint::ArgKind kind,
+                                                  uint32_t index)
+{
+  for (auto& constraint : constraints_)
+    if (constraint.kind == kind && constraint.index == index) return constraint;
+  constraints_.emplace_back();
+  auto& constraint = constraints_.back();
+  constraint.kind  = kind;
+  constraint.index = index;
+  return constraint;
+}
+
+}  // namespace legate
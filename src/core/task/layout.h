@@ -0,0 +1,91 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace legate {
+
+// A layout constraint that a task declares on one of its store arguments. The base mapper
+// honors it in the default mappings of the stores that the library mapper leaves unmapped, as
+// if the library mapper had requested the same layout. Orderings refer to the dimensions of
+// the store's root region, as with mapping::DimOrdering.
+struct StoreLayoutConstraint {
+ public:
+  enum class ArgKind : int32_t {
+    INPUT     = 0,
+    OUTPUT    = 1,
+    REDUCTION = 2,
+  };
+  enum class Ordering : int32_t {
+    ANY     = 0,
+    C       = 1,
+    FORTRAN = 2,
+  };
+
+ public:
+  StoreLayoutConstraint& c_order();
+  StoreLayoutConstraint& fortran_order();
+  // Requests an instance that covers only the store's shape, so that the elements are contiguous
+  StoreLayoutConstraint& contiguous();
+  StoreLayoutConstraint& align(uint32_t bytes);
+
+ public:
+  ArgKind kind{ArgKind::INPUT};
+  uint32_t index{0};
+  Ordering ordering{Ordering::ANY};
+  // Minimum alignment of the instance in bytes; 0 leaves it to the runtime
+  uint32_t alignment{0};
+  bool exact{false};
+};
+
+// Layout constraints of all store arguments of a task. A task declares them by defining
+//
+//   static void layout_constraints(TaskLayoutConstraints& constraints)
+//   {
+//     constraints.input(0).c_order().contiguous().align(64);
+//   }
+//
+// and they are attached to the task as semantic information when its variants are registered.
+class TaskLayoutConstraints {
+ public:
+  TaskLayoutConstraints() {}
+  TaskLayoutConstraints(const void* buffer, size_t size);
+
+ public:
+  StoreLayoutConstraint& input(uint32_t index);
+  StoreLayoutConstraint& output(uint32_t index);
+  StoreLayoutConstraint& reduction(uint32_t index);
+
+ public:
+  bool empty() const { return constraints_.empty(); }
+  const StoreLayoutConstraint* find(StoreLayoutConstraint::ArgKind kind, uint32_t index) const;
+
+ public:
+  const void* data() const { return constraints_.data(); }
+  size_t size() const { return constraints_.size() * sizeof(StoreLayoutConstraint); }
+
+ private:
+  StoreLayoutConstraint& get(StoreLayoutConstraint::ArgKind kind, uint32_t index);
+
+ private:
+  std::vector<StoreLayoutConstraint> constraints_{};
+};
+
+}  // namespace legate
@@ -17,6 +17,10 @@
 #include <assert.h>
 #include <stdint.h>
 #include <string.h>
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <mutex>
 
 #include "legion.h"
 
@@ -26,6 +30,7 @@
 #include "core/task/return.h"
 #include "core/utilities/machine.h"
 #include "core/utilities/typedefs.h"
+#include "legate_defines.h"
 #ifdef LEGATE_USE_CUDA
 #include "core/cuda/cuda_help.h"
 #include "core/cuda/stream_pool.h"
@@ -36,10 +41,10 @@ using namespace Legion;
 namespace legate {
 
 struct JoinReturnedException {
-  using LHS = ReturnedException;
+  using LHS = ExceptionStatus;
   using RHS = LHS;
 
-  static const ReturnedException identity;
+  static const ExceptionStatus identity;
 
   template <bool EXCLUSIVE>
   static void apply(LHS& lhs, RHS rhs)
@@ -47,149 +52,150 @@ struct JoinReturnedException {
 #ifdef DEBUG_LEGATE
     assert(EXCLUSIVE);
 #endif
-    if (lhs.raised() || !rhs.raised()) return;
-    lhs = rhs;
+    fold<EXCLUSIVE>(lhs, rhs);
   }
 
+  // Keeps the status of the lowest point that raised, so the result doesn't depend on the order
+  // in which the points are folded
   template <bool EXCLUSIVE>
   static void fold(RHS& rhs1, RHS rhs2)
   {
 #ifdef DEBUG_LEGATE
     assert(EXCLUSIVE);
 #endif
-    if (rhs1.raised() || !rhs2.raised()) return;
-    rhs1 = rhs2;
+    if (rhs2.index < 0) return;
+    if (rhs1.index < 0 || rhs2.point < rhs1.point) rhs1 = rhs2;
   }
 };
 
-/*static*/ const ReturnedException JoinReturnedException::identity;
+/*static*/ const ExceptionStatus JoinReturnedException::identity{};
 
-static void pack_returned_exception(const ReturnedException& value, void*& ptr, size_t& size)
+ReturnedException::ReturnedException(int32_t index, int64_t point)
+  : status_{index, Processor::get_executing_processor().address_space(), point}
 {
-  auto new_size = value.legion_buffer_size();
-  if (new_size > size) {
-    size = new_size;
-    ptr  = realloc(ptr, new_size);
-  }
-  value.legion_serialize(ptr);
 }
 
-static void returned_exception_init(const ReductionOp* reduction_op, void*& ptr, size_t& size)
+namespace {
+
+ReturnValue pack_bytes(const void* data, size_t size)
 {
-  pack_returned_exception(JoinReturnedException::identity, ptr, size);
-}
+  auto mem_kind = find_memory_kind_for_executing_processor();
+  // Deferred values can't be empty, even when the value is
+  auto buffer = UntypedDeferredValue(std::max<size_t>(size, 1), mem_kind);
 
-static void returned_exception_fold(const ReductionOp* reduction_op,
-                                    void*& lhs_ptr,
-                                    size_t& lhs_size,
-                                    const void* rhs_ptr)
+  AccessorWO<int8_t, 1> acc(buffer, std::max<size_t>(size, 1), false);
+  if (size > 0) memcpy(acc.ptr(0), data, size);
 
-{
-  ReturnedException lhs, rhs;
-  lhs.legion_deserialize(lhs_ptr);
-  rhs.legion_deserialize(rhs_ptr);
-  JoinReturnedException::fold<true>(lhs, rhs);
-  pack_returned_exception(lhs, lhs_ptr, lhs_size);
+  return ReturnValue(buffer, size);
 }
 
-ReturnedException::ReturnedException(int32_t index, const std::string& error_message)
-  : raised_(true), index_(index), error_message_(error_message)
+// Error messages of the points that raised on this node, keyed by the exception id of the launch
+// and the point. Only the message of the point that wins the fold is ever fetched, which also
+// drops the messages of the other points of the launch on the same node; those on other nodes
+// are kept until the process exits.
+std::mutex error_messages_lock{};
+std::map<std::pair<uint64_t, int64_t>, std::string> error_messages{};
+
+}  // namespace
+
+ReturnValue ReturnedException::pack() const
 {
+  return pack_bytes(&status_, sizeof(ExceptionStatus));
 }
 
-size_t ReturnedException::legion_buffer_size() const
+void record_error_message(uint64_t exception_id, int64_t point, const std::string& error_message)
 {
-  size_t size = sizeof(bool);
-  if (raised_) size += sizeof(int32_t) + sizeof(uint32_t) + error_message_.size();
-  return size;
+  std::lock_guard<std::mutex> guard(error_messages_lock);
+  error_messages[std::make_pair(exception_id, point)] = error_message;
 }
 
-void ReturnedException::legion_serialize(void* buffer) const
+ReturnValue fetch_error_message(uint64_t exception_id, int64_t point)
 {
-  int8_t* ptr                   = static_cast<int8_t*>(buffer);
-  *reinterpret_cast<bool*>(ptr) = raised_;
-  if (raised_) {
-    ptr += sizeof(bool);
-    *reinterpret_cast<int32_t*>(ptr) = index_;
-    ptr += sizeof(int32_t);
-    uint32_t error_len                = static_cast<uint32_t>(error_message_.size());
-    *reinterpret_cast<uint32_t*>(ptr) = error_len;
-    ptr += sizeof(uint32_t);
-    memcpy(ptr, error_message_.c_str(), error_len);
+  std::string error_message;
+  {
+    std::lock_guard<std::mutex> guard(error_messages_lock);
+    auto finder = error_messages.find(std::make_pair(exception_id, point));
+#ifdef DEBUG_LEGATE
+    assert(finder != error_messages.end());
+#endif
+    if (finder != error_messages.end()) error_message = std::move(finder->second);
+
+    auto lo = error_messages.lower_bound(
+      std::make_pair(exception_id, std::numeric_limits<int64_t>::min()));
+    auto hi = error_messages.upper_bound(
+      std::make_pair(exception_id, std::numeric_limits<int64_t>::max()));
+    error_messages.erase(lo, hi);
   }
+  return pack_bytes(error_message.data(), error_message.size());
 }
 
-void ReturnedException::legion_deserialize(const void* buffer)
+namespace {
+
+// Alignment of the values in a packed buffer
+constexpr size_t RETURN_VALUE_ALIGNMENT = 16;
+
+// Computes the offsets of the values in the packed buffer and returns the size of the buffer.
+// A single value is returned as is, without a header.
+size_t compute_layout(const std::vector<size_t>& sizes, std::vector<size_t>& offsets)
 {
-  const int8_t* ptr = static_cast<const int8_t*>(buffer);
-  raised_           = *reinterpret_cast<const bool*>(ptr);
-  if (raised_) {
-    ptr += sizeof(bool);
-    index_ = *reinterpret_cast<const int32_t*>(ptr);
-    ptr += sizeof(int32_t);
-    uint32_t error_len = *reinterpret_cast<const uint32_t*>(ptr);
-    ptr += sizeof(uint32_t);
-    error_message_ = std::string(ptr, ptr + error_len);
+  offsets.clear();
+  if (sizes.empty()) return 0;
+  if (sizes.size() == 1) {
+    offsets.push_back(0);
+    return sizes.front();
   }
+
+  size_t offset = sizeof(uint32_t) * (sizes.size() + 1);
+  for (auto size : sizes) {
+    offset = (offset + RETURN_VALUE_ALIGNMENT - 1) / RETURN_VALUE_ALIGNMENT;
+    offset *= RETURN_VALUE_ALIGNMENT;
+    offsets.push_back(offset);
+    offset += size;
+  }
+  return offset;
 }
 
-ReturnValue ReturnedException::pack() const
+void pack_header(int8_t* target, const std::vector<size_t>& sizes)
 {
-  auto buffer_size = legion_buffer_size();
-  auto mem_kind    = find_memory_kind_for_executing_processor();
-  auto buffer      = UntypedDeferredValue(buffer_size, mem_kind);
-
-  AccessorWO<int8_t, 1> acc(buffer, buffer_size, false);
-  legion_serialize(acc.ptr(0));
-
-  return ReturnValue(buffer, buffer_size);
+  auto header = reinterpret_cast<uint32_t*>(target);
+  header[0]   = static_cast<uint32_t>(sizes.size());
+  for (size_t idx = 0; idx < sizes.size(); ++idx) header[idx + 1] = sizes[idx];
 }
 
-namespace {
-
-template <bool PACK_SIZE>
-int8_t* pack_return_value(int8_t* target, const ReturnValue& value)
+void pack_return_value(int8_t* target, const ReturnValue& value)
 {
-  if constexpr (PACK_SIZE) {
-    *reinterpret_cast<uint32_t*>(target) = value.second;
-    target += sizeof(uint32_t);
-  }
-
   AccessorRO<int8_t, 1> acc(value.first, value.second, false);
   memcpy(target, acc.ptr(0), value.second);
-  return target + value.second;
 }
 
 #ifdef LEGATE_USE_CUDA
 
-template <bool PACK_SIZE>
-int8_t* pack_return_value(int8_t* target, const ReturnValue& value, cuda::StreamView& stream)
+void pack_return_value(int8_t* target, const ReturnValue& value, cuda::StreamView& stream)
 {
-  if constexpr (PACK_SIZE) {
-    *reinterpret_cast<uint32_t*>(target) = value.second;
-    target += sizeof(uint32_t);
-  }
-
   AccessorRO<int8_t, 1> acc(value.first, value.second, false);
   CHECK_CUDA(cudaMemcpyAsync(target, acc.ptr(0), value.second, cudaMemcpyDeviceToHost, stream));
-  return target + value.second;
 }
 
 #endif
 
-ReturnValue unpack_return_value(const int8_t*& ptr, Memory::Kind memory_kind)
+ReturnValue unpack_return_value(const int8_t* ptr, size_t size, Memory::Kind memory_kind)
 {
-  auto size = *reinterpret_cast<const uint32_t*>(ptr);
-  ptr += sizeof(uint32_t);
-
-  UntypedDeferredValue value(size, memory_kind);
-  AccessorWO<int8_t, 1> acc(value, size, false);
-  memcpy(acc.ptr(0), ptr, size);
-  ptr += size;
-
+  // Same as in pack_bytes, an empty value still gets a non-empty deferred value
+  UntypedDeferredValue value(std::max<size_t>(size, 1), memory_kind);
+  AccessorWO<int8_t, 1> acc(value, std::max<size_t>(size, 1), false);
+  if (size > 0) memcpy(acc.ptr(0), ptr, size);
   return ReturnValue(value, size);
 }
 
+// Return values have no size bound other than the 32-bit size fields of the packed format
+void check_return_value_size(size_t size)
+{
+  if (size > std::numeric_limits<uint32_t>::max()) {
+    log_legate.error("Task return value of %zu bytes exceeds the 4 GiB limit", size);
+    LEGATE_ABORT;
+  }
+}
+
 }  // namespace
 
 ReturnValues::ReturnValues() {}
@@ -197,44 +203,60 @@ ReturnValues::ReturnValues() {}
 ReturnValues::ReturnValues(std::vector<ReturnValue>&& return_values)
   : return_values_(std::move(return_values))
 {
-  if (return_values_.size() > 1) {
-    buffer_size_ += sizeof(uint32_t);
-    for (auto& ret : return_values_) buffer_size_ += sizeof(uint32_t) + ret.second;
-  } else if (return_values_.size() > 0)
-    buffer_size_ = return_values_[0].second;
+  for (auto& ret : return_values_) {
+    check_return_value_size(ret.second);
+    sizes_.push_back(ret.second);
+  }
+  buffer_size_ = compute_layout(sizes_, offsets_);
+}
+
+ReturnValues::ReturnValues(const std::vector<size_t>& sizes, Memory::Kind memory_kind)
+  : in_place_(true), sizes_(sizes)
+{
+  for (auto size : sizes_) check_return_value_size(size);
+  buffer_size_ = compute_layout(sizes_, offsets_);
+  buffer_      = UntypedDeferredValue(buffer_size_, memory_kind);
+  if (sizes_.size() > 1) {
+    AccessorWO<int8_t, 1> acc(buffer_, buffer_size_, false);
+    pack_header(acc.ptr(0), sizes_);
+  }
 }
 
 ReturnValue ReturnValues::operator[](int32_t idx) const { return return_values_[idx]; }
 
+void* ReturnValues::slot(int32_t idx) const
+{
+#ifdef DEBUG_LEGATE
+  assert(in_place_);
+#endif
+  AccessorWO<int8_t, 1> acc(buffer_, buffer_size_, false);
+  return acc.ptr(0) + offsets_[idx];
+}
+
 size_t ReturnValues::legion_buffer_size() const { return buffer_size_; }
 
 void ReturnValues::legion_serialize(void* buffer) const
 {
+  auto ptr = static_cast<int8_t*>(buffer);
+  if (in_place_) {
+    AccessorRO<int8_t, 1> acc(buffer_, buffer_size_, false);
+    memcpy(ptr, acc.ptr(0), buffer_size_);
+    return;
+  }
+
 #ifdef LEGATE_USE_CUDA
   auto stream = cuda::StreamPool::get_stream_pool().get_stream();
 #endif
 
-  auto ptr = static_cast<int8_t*>(buffer);
-  if (return_values_.size() == 1) {
-    auto& ret = return_values_.front();
+  if (return_values_.size() > 1) pack_header(ptr, sizes_);
+  for (uint32_t idx = 0; idx < return_values_.size(); ++idx) {
+    auto& ret = return_values_[idx];
 #ifdef LEGATE_USE_CUDA
     if (ret.first.get_instance().get_location().kind() == Memory::Kind::GPU_FB_MEM)
-      ptr = pack_return_value<false>(ptr, ret, stream);
+      pack_return_value(ptr + offsets_[idx], ret, stream);
     else
 #endif
-      ptr = pack_return_value<false>(ptr, ret);
-  } else {
-    *reinterpret_cast<uint32_t*>(ptr) = return_values_.size();
-    ptr += sizeof(uint32_t);
-
-    for (auto& ret : return_values_) {
-#ifdef LEGATE_USE_CUDA
-      if (ret.first.get_instance().get_location().kind() == Memory::Kind::GPU_FB_MEM)
-        ptr = pack_return_value<true>(ptr, ret, stream);
-      else
-#endif
-        ptr = pack_return_value<true>(ptr, ret);
-    }
+      pack_return_value(ptr + offsets_[idx], ret);
   }
 }
 
@@ -243,17 +265,24 @@ void ReturnValues::legion_deserialize(const void* buffer)
   auto mem_kind = find_memory_kind_for_executing_processor();
 
   auto ptr        = static_cast<const int8_t*>(buffer);
-  auto num_values = *reinterpret_cast<const uint32_t*>(ptr);
-  ptr += sizeof(uint32_t);
-  return_values_.resize(num_values);
-
-  for (auto& ret : return_values_) ret = unpack_return_value(ptr, mem_kind);
-  buffer_size_ = ptr - static_cast<const int8_t*>(buffer);
+  auto header     = reinterpret_cast<const uint32_t*>(ptr);
+  auto num_values = header[0];
+  sizes_.assign(header + 1, header + 1 + num_values);
+  buffer_size_ = compute_layout(sizes_, offsets_);
+
+  return_values_.clear();
+  return_values_.reserve(num_values);
+  for (uint32_t idx = 0; idx < num_values; ++idx)
+    return_values_.push_back(unpack_return_value(ptr + offsets_[idx], sizes_[idx], mem_kind));
 }
 
 void ReturnValues::finalize(Context legion_context) const
 {
-  if (return_values_.empty()) {
+  // Values written in place are handed off as they are
+  if (in_place_) {
+    buffer_.finalize(legion_context);
+    return;
+  } else if (return_values_.empty()) {
     Runtime::legion_task_postamble(legion_context);
     return;
   } else if (return_values_.size() == 1) {
@@ -282,7 +311,7 @@ void register_exception_reduction_op(Runtime* runtime, const LibraryContext& con
 {
   auto redop_id = context.get_reduction_op_id(LEGATE_CORE_JOIN_EXCEPTION_OP);
   auto* redop   = Realm::ReductionOpUntyped::create_reduction_op<JoinReturnedException>();
-  Runtime::register_reduction_op(redop_id, redop, returned_exception_init, returned_exception_fold);
+  Runtime::register_reduction_op(redop_id, redop);
 }
 
 }  // namespace legate
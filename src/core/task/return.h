@@ -16,38 +16,57 @@
 
 #pragma once
 
+#include <string>
 #include <vector>
 
 namespace legate {
 
 using ReturnValue = std::pair<Legion::UntypedDeferredValue, size_t>;
 
+// Status of a task that can raise an exception. The statuses of the points of an index task are
+// folded with a plain reduction, which keeps the one of the first point that raised, so only that
+// point's error message ever needs to be fetched.
+struct ExceptionStatus {
+  // Index of the exception in the list of exceptions the task declared, or -1 if none was raised
+  int32_t index{-1};
+  // Node that keeps the error message until it is fetched
+  uint32_t node{0};
+  // Linearized index of the point that raised within the launch domain
+  int64_t point{0};
+};
+
+// A task that can raise an exception returns only its status. The error message of a point that
+// raised stays on the node that ran it, keyed by the exception id of the launch and the point,
+// and is fetched by a separate task only when the status says that an exception was raised.
 struct ReturnedException {
  public:
   ReturnedException() {}
-  ReturnedException(int32_t index, const std::string& error_message);
-
- public:
-  bool raised() const { return raised_; }
+  ReturnedException(int32_t index, int64_t point);
 
  public:
-  size_t legion_buffer_size() const;
-  void legion_serialize(void* buffer) const;
-  void legion_deserialize(const void* buffer);
+  bool raised() const { return status_.index >= 0; }
+  const ExceptionStatus& status() const { return status_; }
 
  public:
   ReturnValue pack() const;
 
  private:
-  bool raised_{false};
-  int32_t index_{-1};
-  std::string error_message_{};
+  ExceptionStatus status_{};
 };
 
+void record_error_message(uint64_t exception_id, int64_t point, const std::string& error_message);
+// Removes the error message from the node and returns it
+ReturnValue fetch_error_message(uint64_t exception_id, int64_t point);
+
+// When a task has several return values, they are packed into one buffer: the number of values
+// and their sizes, as 32-bit integers, followed by the values at aligned offsets, so that a task
+// can write its values in place.
 struct ReturnValues {
  public:
   ReturnValues();
   ReturnValues(std::vector<ReturnValue>&& return_values);
+  // Allocates a packed buffer with slots for values of the given sizes
+  ReturnValues(const std::vector<size_t>& sizes, Legion::Memory::Kind memory_kind);
 
  public:
   ReturnValues(const ReturnValues&)            = default;
@@ -60,6 +79,13 @@ struct ReturnValues {
  public:
   ReturnValue operator[](int32_t idx) const;
 
+ public:
+  bool in_place() const { return in_place_; }
+  size_t size() const { return sizes_.size(); }
+  const Legion::UntypedDeferredValue& buffer() const { return buffer_; }
+  size_t offset(int32_t idx) const { return offsets_[idx]; }
+  void* slot(int32_t idx) const;
+
  public:
   size_t legion_buffer_size() const;
   void legion_serialize(void* buffer) const;
@@ -72,6 +98,12 @@ struct ReturnValues {
  private:
   size_t buffer_size_{0};
   std::vector<ReturnValue> return_values_{};
+
+ private:
+  bool in_place_{false};
+  Legion::UntypedDeferredValue buffer_{};
+  std::vector<size_t> sizes_{};
+  std::vector<size_t> offsets_{};
 };
 
 }  // namespace legate
@@ -0,0 +1,97 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/task/signature.h"
+#include "legate_defines.h"
+
+namespace legate {
+
+static const char* kind_name(SignatureArgKind kind)
+{
+  switch (kind) {
+    case SignatureArgKind::INPUT: return "input";
+    case SignatureArgKind::OUTPUT: return "output";
+    case SignatureArgKind::REDUCTION: return "reduction";
+    case SignatureArgKind::SCALAR: return "scalar";
+  }
+  return "unknown";
+}
+
+static void check_count(SignatureArgKind kind, size_t received, uint32_t declared)
+{
+  if (received == declared) return;
+  log_legate.error("Task signature mismatch: the signature declares %u %s arguments, but the task "
+                   "received %zu",
+                   declared,
+                   kind_name(kind),
+                   received);
+  LEGATE_ABORT;
+}
+
+void check_signature_arity(TaskContext& context,
+                           uint32_t num_inputs,
+                           uint32_t num_outputs,
+                           uint32_t num_reductions,
+                           uint32_t num_scalars)
+{
+  check_count(SignatureArgKind::INPUT, context.inputs().size(), num_inputs);
+  check_count(SignatureArgKind::OUTPUT, context.outputs().size(), num_outputs);
+  check_count(SignatureArgKind::REDUCTION, context.reductions().size(), num_reductions);
+  check_count(SignatureArgKind::SCALAR, context.scalars().size(), num_scalars);
+}
+
+void check_signature_store(const Store& store,
+                           SignatureArgKind kind,
+                           uint32_t position,
+                           int32_t dim,
+                           LegateTypeCode code)
+{
+  // 0-D stores are accessed as 1-D ones, as in Store::check_accessor_dimension
+  if (!(store.dim() == dim || (store.dim() == 0 && dim == 1))) {
+    log_legate.error("Task signature mismatch: %s %u is declared %d-D, but the task received a "
+                     "%d-D store",
+                     kind_name(kind),
+                     position,
+                     dim,
+                     store.dim());
+    LEGATE_ABORT;
+  }
+  // Types without a type code can't be checked
+  if (code != MAX_TYPE_NUMBER && store.code() != code) {
+    log_legate.error("Task signature mismatch: %s %u is declared with type code %d, but the task "
+                     "received a store of type code %d",
+                     kind_name(kind),
+                     position,
+                     static_cast<int32_t>(code),
+                     static_cast<int32_t>(store.code()));
+    LEGATE_ABORT;
+  }
+}
+
+void check_signature_scalar(const Scalar& scalar, uint32_t position, LegateTypeCode code)
+{
+  if (code != MAX_TYPE_NUMBER && (scalar.is_tuple() || scalar.code() != code)) {
+    log_legate.error("Task signature mismatch: scalar %u is declared with type code %d, but the "
+                     "task received a %s of type code %d",
+                     position,
+                     static_cast<int32_t>(code),
+                     scalar.is_tuple() ? "tuple" : "scalar",
+                     static_cast<int32_t>(scalar.code()));
+    LEGATE_ABORT;
+  }
+}
+
+}  // namespace legate
@@ -0,0 +1,245 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <tuple>
+#include <utility>
+
+#include "core/data/scalar.h"
+#include "core/data/store.h"
+#include "core/runtime/context.h"
+#include "core/utilities/type_traits.h"
+#include "core/utilities/typedefs.h"
+
+// Typed task signatures
+//
+// A task whose arguments always have the same types and dimensions can declare them once and
+// unpack its context into statically typed views, instead of dispatching on the type code and
+// dimension of each store:
+//
+//   class SaxpyTask : public LegateTask<SaxpyTask> {
+//    public:
+//     using Signature =
+//       TaskSignature<InputStore<float, 1>, OutputStore<float, 1>, ScalarArg<float>>;
+//
+//    public:
+//     static void cpu_variant(TaskContext& context)
+//     {
+//       auto [x, y, alpha] = unpack_arguments<Signature>(context);
+//       auto in            = x.accessor();
+//       auto out           = y.accessor();
+//       for (PointInRectIterator<1> it(x.shape()); it.valid(); ++it) out[*it] = alpha * in[*it];
+//     }
+//   };
+//
+// Arguments of each kind are taken from the context in the order in which they appear in the
+// signature. With DEBUG_LEGATE, the number of arguments of each kind and the type and dimension
+// of each argument are checked against what the task received. The views refer to the stores
+// of the context and must not outlive it.
+
+namespace legate {
+
+enum class SignatureArgKind : int32_t {
+  INPUT     = 0,
+  OUTPUT    = 1,
+  REDUCTION = 2,
+  SCALAR    = 3,
+};
+
+template <typename T, int32_t DIM>
+class InputStore {
+ public:
+  using value_type                       = T;
+  static constexpr int32_t dim           = DIM;
+  static constexpr SignatureArgKind kind = SignatureArgKind::INPUT;
+
+ public:
+  explicit InputStore(Store& store) : store_(&store) {}
+
+ public:
+  Legion::Rect<DIM> shape() const { return store_->shape<DIM>(); }
+  AccessorRO<T, DIM> accessor() const { return store_->read_accessor<T, DIM>(); }
+  AccessorRO<T, DIM> accessor(const Legion::Rect<DIM>& bounds) const
+  {
+    return store_->read_accessor<T, DIM>(bounds);
+  }
+  Store& store() const { return *store_; }
+
+ private:
+  Store* store_;
+};
+
+template <typename T, int32_t DIM>
+class OutputStore {
+ public:
+  using value_type                       = T;
+  static constexpr int32_t dim           = DIM;
+  static constexpr SignatureArgKind kind = SignatureArgKind::OUTPUT;
+
+ public:
+  explicit OutputStore(Store& store) : store_(&store) {}
+
+ public:
+  Legion::Rect<DIM> shape() const { return store_->shape<DIM>(); }
+  AccessorWO<T, DIM> accessor() const { return store_->write_accessor<T, DIM>(); }
+  AccessorWO<T, DIM> accessor(const Legion::Rect<DIM>& bounds) const
+  {
+    return store_->write_accessor<T, DIM>(bounds);
+  }
+  AccessorRW<T, DIM> read_write_accessor() const { return store_->read_write_accessor<T, DIM>(); }
+  AccessorRW<T, DIM> read_write_accessor(const Legion::Rect<DIM>& bounds) const
+  {
+    return store_->read_write_accessor<T, DIM>(bounds);
+  }
+  Buffer<T, DIM> create_output_buffer(const Legion::Point<DIM>& extents,
+                                      bool return_buffer = false) const
+  {
+    return store_->create_output_buffer<T, DIM>(extents, return_buffer);
+  }
+  Store& store() const { return *store_; }
+
+ private:
+  Store* store_;
+};
+
+template <typename OP, int32_t DIM>
+class ReductionStore {
+ public:
+  using value_type                       = typename OP::RHS;
+  static constexpr int32_t dim           = DIM;
+  static constexpr SignatureArgKind kind = SignatureArgKind::REDUCTION;
+
+ public:
+  explicit ReductionStore(Store& store) : store_(&store) {}
+
+ public:
+  Legion::Rect<DIM> shape() const { return store_->shape<DIM>(); }
+  template <bool EXCLUSIVE>
+  AccessorRD<OP, EXCLUSIVE, DIM> accessor() const
+  {
+    return store_->reduce_accessor<OP, EXCLUSIVE, DIM>();
+  }
+  template <bool EXCLUSIVE>
+  AccessorRD<OP, EXCLUSIVE, DIM> accessor(const Legion::Rect<DIM>& bounds) const
+  {
+    return store_->reduce_accessor<OP, EXCLUSIVE, DIM>(bounds);
+  }
+  Store& store() const { return *store_; }
+
+ private:
+  Store* store_;
+};
+
+// Unpacks to the value of the scalar argument itself
+template <typename T>
+struct ScalarArg {
+  using value_type                       = T;
+  static constexpr SignatureArgKind kind = SignatureArgKind::SCALAR;
+};
+
+template <typename... ARGS>
+struct TaskSignature {
+  static constexpr size_t size = sizeof...(ARGS);
+
+  template <SignatureArgKind KIND>
+  static constexpr uint32_t count()
+  {
+    return (static_cast<uint32_t>(ARGS::kind == KIND) + ... + 0);
+  }
+
+  // Position of the IDX-th argument among the arguments of the same kind
+  template <size_t IDX>
+  static constexpr uint32_t position()
+  {
+    constexpr SignatureArgKind kinds[] = {ARGS::kind...};
+    uint32_t pos                       = 0;
+    for (size_t idx = 0; idx < IDX; ++idx) pos += kinds[idx] == kinds[IDX];
+    return pos;
+  }
+};
+
+void check_signature_arity(TaskContext& context,
+                           uint32_t num_inputs,
+                           uint32_t num_outputs,
+                           uint32_t num_reductions,
+                           uint32_t num_scalars);
+void check_signature_store(const Store& store,
+                           SignatureArgKind kind,
+                           uint32_t position,
+                           int32_t dim,
+                           LegateTypeCode code);
+void check_signature_scalar(const Scalar& scalar, uint32_t position, LegateTypeCode code);
+
+template <typename ARG>
+struct unpack_signature_arg_fn {
+  using result_type = ARG;
+
+  ARG operator()(TaskContext& context, uint32_t position) const
+  {
+    std::vector<Store>* stores = nullptr;
+    switch (ARG::kind) {
+      case SignatureArgKind::INPUT: stores = &context.inputs(); break;
+      case SignatureArgKind::OUTPUT: stores = &context.outputs(); break;
+      default: stores = &context.reductions(); break;
+    }
+    auto& store = (*stores)[position];
+#ifdef DEBUG_LEGATE
+    check_signature_store(
+      store, ARG::kind, position, ARG::dim, legate_type_code_of<typename ARG::value_type>);
+#endif
+    return ARG(store);
+  }
+};
+
+template <typename T>
+struct unpack_signature_arg_fn<ScalarArg<T>> {
+  using result_type = T;
+
+  T operator()(TaskContext& context, uint32_t position) const
+  {
+    auto& scalar = context.scalars()[position];
+#ifdef DEBUG_LEGATE
+    check_signature_scalar(scalar, position, legate_type_code_of<T>);
+#endif
+    return scalar.value<T>();
+  }
+};
+
+template <typename... ARGS, size_t... IDX>
+std::tuple<typename unpack_signature_arg_fn<ARGS>::result_type...> unpack_arguments(
+  TaskContext& context, TaskSignature<ARGS...>, std::index_sequence<IDX...>)
+{
+  using SIGNATURE = TaskSignature<ARGS...>;
+#ifdef DEBUG_LEGATE
+  check_signature_arity(context,
+                        SIGNATURE::template count<SignatureArgKind::INPUT>(),
+                        SIGNATURE::template count<SignatureArgKind::OUTPUT>(),
+                        SIGNATURE::template count<SignatureArgKind::REDUCTION>(),
+                        SIGNATURE::template count<SignatureArgKind::SCALAR>());
+#endif
+  // Braced initialization evaluates the arguments in order
+  return {unpack_signature_arg_fn<ARGS>{}(context, SIGNATURE::template position<IDX>())...};
+}
+
+// Returns a tuple with one typed view, or scalar value, per argument of the signature
+template <typename SIGNATURE>
+auto unpack_arguments(TaskContext& context)
+{
+  return unpack_arguments(context, SIGNATURE{}, std::make_index_sequence<SIGNATURE::size>{});
+}
+
+}  // namespace legate
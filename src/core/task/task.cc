@@ -30,7 +30,7 @@ void LegateTaskRegistrar::record_variant(TaskID tid,
                                          bool leaf,
                                          bool inner,
                                          bool idempotent,
-                                         size_t ret_size)
+                                         const TaskLayoutConstraints& store_layouts)
 {
   assert((kind == Processor::LOC_PROC) || (kind == Processor::TOC_PROC) ||
          (kind == Processor::OMP_PROC));
@@ -43,8 +43,7 @@ void LegateTaskRegistrar::record_variant(TaskID tid,
                                                                                       : "OpenMP",
                                                       task_name,
                                                       descriptor,
-                                                      var,
-                                                      ret_size));
+                                                      var));
 
   auto& registrar = pending_task_variants_.back();
   registrar.execution_constraints.swap(execution_constraints);
@@ -53,6 +52,32 @@ void LegateTaskRegistrar::record_variant(TaskID tid,
   registrar.set_leaf(leaf);
   registrar.set_inner(inner);
   registrar.set_idempotent(idempotent);
+  registrar.store_layouts = store_layouts;
+}
+
+void LegateTaskRegistrar::record_variant(TaskID tid,
+                                         const char* task_name,
+                                         const CodeDescriptor& descriptor,
+                                         ExecutionConstraintSet& execution_constraints,
+                                         TaskLayoutConstraintSet& layout_constraints,
+                                         LegateVariantCode var,
+                                         Processor::Kind kind,
+                                         bool leaf,
+                                         bool inner,
+                                         bool idempotent,
+                                         size_t /*ret_size*/)
+{
+  record_variant(tid,
+                 task_name,
+                 descriptor,
+                 execution_constraints,
+                 layout_constraints,
+                 var,
+                 kind,
+                 leaf,
+                 inner,
+                 idempotent,
+                 TaskLayoutConstraints{});
 }
 
 void LegateTaskRegistrar::register_all_tasks(Runtime* runtime, LibraryContext& context)
@@ -63,7 +88,22 @@ void LegateTaskRegistrar::register_all_tasks(Runtime* runtime, LibraryContext& c
       context.get_task_id(task.task_id);  // Convert a task local task id to a global id
     // Attach the task name too for debugging
     runtime->attach_name(task.task_id, task.task_name, false /*mutable*/, true /*local only*/);
-    runtime->register_task_variant(task, task.descriptor, nullptr, 0, task.ret_size, task.var);
+    // The mapper looks up the layout constraints of the stores by the task id
+    if (!task.store_layouts.empty())
+      runtime->attach_semantic_information(task.task_id,
+                                           LEGATE_CORE_STORE_LAYOUTS_SEMANTIC_TAG,
+                                           task.store_layouts.data(),
+                                           task.store_layouts.size(),
+                                           true /*mutable*/,
+                                           true /*local only*/);
+    // Tasks return values of arbitrary sizes, which the runtime learns when they finish
+    runtime->register_task_variant(task,
+                                   task.descriptor,
+                                   nullptr,
+                                   0,
+                                   0 /*return_type_size*/,
+                                   task.var,
+                                   false /*has_return_type_size*/);
   }
   pending_task_variants_.clear();
 }
@@ -18,6 +18,7 @@
 
 #include <cxxabi.h>
 #include <sstream>
+#include <utility>
 
 #include "legion.h"
 #include "realm/faults.h"
@@ -25,15 +26,19 @@
 #include "core/runtime/context.h"
 #include "core/runtime/runtime.h"
 #include "core/task/exception.h"
+#include "core/task/layout.h"
 #include "core/task/return.h"
+#include "core/task/task_timer.h"
 #include "core/utilities/deserializer.h"
 #include "core/utilities/nvtx_help.h"
 #include "core/utilities/typedefs.h"
 
 namespace legate {
 
-// We're going to allow for each task to use only up to 170 scalar output stores
-constexpr size_t LEGATE_MAX_SIZE_SCALAR_RETURN = 2048;
+// Task variants are no longer registered with a fixed return size; the size of each returned
+// future is taken from the values the task finalizes
+[[deprecated("Task return values are no longer bounded by a fixed size")]] constexpr size_t
+  LEGATE_MAX_SIZE_SCALAR_RETURN = 2048;
 
 using LegateVariantImpl = void (*)(TaskContext&);
 
@@ -64,6 +69,32 @@ class LegateTask {
     static __no& test(...);
     static const bool value = (sizeof(test<T>(0)) == sizeof(__yes));
   };
+  struct HasLayoutConstraints {
+    template <typename U>
+    static __yes& test(decltype(&U::layout_constraints));
+    template <typename U>
+    static __no& test(...);
+    static const bool value = (sizeof(test<T>(0)) == sizeof(__yes));
+  };
+  // Registrars written against older versions take a return size in place of the store layout
+  // constraints
+  struct RegistrarTakesStoreLayouts {
+    template <typename U>
+    static __yes& test(decltype(U::record_variant(std::declval<Legion::TaskID>(),
+                                                  std::declval<const char*>(),
+                                                  std::declval<const Legion::CodeDescriptor&>(),
+                                                  std::declval<Legion::ExecutionConstraintSet&>(),
+                                                  std::declval<Legion::TaskLayoutConstraintSet&>(),
+                                                  std::declval<LegateVariantCode>(),
+                                                  std::declval<Legion::Processor::Kind>(),
+                                                  std::declval<bool>(),
+                                                  std::declval<bool>(),
+                                                  std::declval<bool>(),
+                                                  std::declval<const TaskLayoutConstraints&>()))*);
+    template <typename U>
+    static __no& test(...);
+    static const bool value = (sizeof(test<typename T::Registrar>(0)) == sizeof(__yes));
+  };
 
  public:
   static void register_variants();
@@ -96,19 +127,22 @@ class LegateTask {
     Legion::Runtime* runtime;
     Legion::Runtime::legion_task_preamble(args, arglen, p, task, regions, legion_context, runtime);
 
-#ifdef LEGATE_USE_CUDA
     nvtx::Range auto_range(task_name());
-#endif
 
     Core::show_progress(task, legion_context, runtime, task_name());
 
+    TaskTimer timer(task_name(), p);
+
     TaskContext context(task, *regions, legion_context, runtime);
+    timer.end_phase(TaskTimer::DESERIALIZE);
 
     ReturnValues return_values{};
     try {
       if (!Core::use_empty_task) (*TASK_PTR)(context);
+      timer.end_phase(TaskTimer::BODY);
       return_values = context.pack_return_values();
     } catch (legate::TaskException& e) {
+      timer.end_phase(TaskTimer::BODY);
       if (context.can_raise_exception()) {
         context.make_all_unbound_stores_empty();
         return_values = context.pack_return_values_with_exception(e.index(), e.error_message());
@@ -120,6 +154,7 @@ class LegateTask {
 
     // Legion postamble
     return_values.finalize(legion_context);
+    timer.end_phase(TaskTimer::PACK);
   }
 
  public:
@@ -138,17 +173,41 @@ class LegateTask {
     Legion::CodeDescriptor desc(legate_task_wrapper<TASK_PTR>);
     auto task_id = T::TASK_ID;
 
-    T::Registrar::record_variant(task_id,
-                                 T::task_name(),
-                                 desc,
-                                 execution_constraints,
-                                 layout_constraints,
-                                 var,
-                                 kind,
-                                 leaf,
-                                 inner,
-                                 idempotent,
-                                 LEGATE_MAX_SIZE_SCALAR_RETURN);
+    // Layout constraints on store arguments can't go in the variant's layout constraint set,
+    // as the region requirement that a store maps to is only known at launch time
+    TaskLayoutConstraints store_layouts;
+    if constexpr (HasLayoutConstraints::value) T::layout_constraints(store_layouts);
+
+    if constexpr (RegistrarTakesStoreLayouts::value) {
+      T::Registrar::record_variant(task_id,
+                                   T::task_name(),
+                                   desc,
+                                   execution_constraints,
+                                   layout_constraints,
+                                   var,
+                                   kind,
+                                   leaf,
+                                   inner,
+                                   idempotent,
+                                   store_layouts);
+    } else {
+      static_assert(!HasLayoutConstraints::value,
+                    "Tasks with layout constraints need a registrar whose record_variant takes "
+                    "the store layout constraints");
+      // The return size is ignored, as return values are no longer bounded by a fixed size
+      constexpr size_t LEGACY_RETURN_SIZE = 2048;
+      T::Registrar::record_variant(task_id,
+                                   T::task_name(),
+                                   desc,
+                                   execution_constraints,
+                                   layout_constraints,
+                                   var,
+                                   kind,
+                                   leaf,
+                                   inner,
+                                   idempotent,
+                                   LEGACY_RETURN_SIZE);
+    }
   }
 };
 
@@ -244,7 +303,19 @@ class LegateTaskRegistrar {
                       bool leaf,
                       bool inner,
                       bool idempotent,
-                      size_t ret_size);
+                      const TaskLayoutConstraints& store_layouts);
+  [[deprecated("The return size is ignored; pass the store layout constraints instead")]] void
+  record_variant(Legion::TaskID tid,
+                 const char* task_name,
+                 const Legion::CodeDescriptor& desc,
+                 Legion::ExecutionConstraintSet& execution_constraints,
+                 Legion::TaskLayoutConstraintSet& layout_constraints,
+                 LegateVariantCode var,
+                 Legion::Processor::Kind kind,
+                 bool leaf,
+                 bool inner,
+                 bool idempotent,
+                 size_t ret_size);
 
  public:
   void register_all_tasks(Legion::Runtime* runtime, LibraryContext& context);
@@ -261,13 +332,11 @@ class LegateTaskRegistrar {
                        const char* var_name,
                        const char* t_name,
                        const Legion::CodeDescriptor& desc,
-                       LegateVariantCode v,
-                       size_t ret)
+                       LegateVariantCode v)
       : Legion::TaskVariantRegistrar(tid, global, var_name),
         task_name(t_name),
         descriptor(desc),
-        var(v),
-        ret_size(ret)
+        var(v)
     {
     }
 
@@ -275,7 +344,7 @@ class LegateTaskRegistrar {
     const char* task_name;
     Legion::CodeDescriptor descriptor;
     LegateVariantCode var;
-    size_t ret_size;
+    TaskLayoutConstraints store_layouts;
   };
 
  private:
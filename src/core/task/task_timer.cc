@@ -0,0 +1,238 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "core/task/task_timer.h"
+
+namespace legate {
+
+namespace {
+
+// Bucket i of a histogram counts the durations in [2^i, 2^(i+1)) nanoseconds
+constexpr int32_t NUM_BUCKETS = 40;
+
+const char* const PHASE_NAMES[TaskTimer::NUM_PHASES] = {"deserialize", "body", "pack"};
+
+struct PhaseStats {
+  uint64_t count{0};
+  uint64_t total_ns{0};
+  uint64_t min_ns{UINT64_MAX};
+  uint64_t max_ns{0};
+  uint64_t histogram[NUM_BUCKETS]{};
+
+  void add(uint64_t ns)
+  {
+    ++count;
+    total_ns += ns;
+    min_ns = std::min(min_ns, ns);
+    max_ns = std::max(max_ns, ns);
+    int32_t bucket = ns == 0 ? 0 : 63 - __builtin_clzll(ns);
+    ++histogram[std::min(bucket, NUM_BUCKETS - 1)];
+  }
+
+  void merge(const PhaseStats& other)
+  {
+    count += other.count;
+    total_ns += other.total_ns;
+    min_ns = std::min(min_ns, other.min_ns);
+    max_ns = std::max(max_ns, other.max_ns);
+    for (int32_t idx = 0; idx < NUM_BUCKETS; ++idx) histogram[idx] += other.histogram[idx];
+  }
+
+  // Estimates a quantile by the upper bound of the bucket that holds it
+  uint64_t quantile(double q) const
+  {
+    uint64_t rank = static_cast<uint64_t>(q * count), seen = 0;
+    for (int32_t idx = 0; idx < NUM_BUCKETS; ++idx) {
+      seen += histogram[idx];
+      if (seen > rank) return std::min(max_ns, (uint64_t{2} << idx) - 1);
+    }
+    return max_ns;
+  }
+};
+
+struct TaskStats {
+  PhaseStats phases[TaskTimer::NUM_PHASES];
+};
+
+// Task names are the strings returned by LegateTask<T>::task_name(), which live as long as the
+// process, so their addresses identify the tasks
+using TaskKey      = std::pair<const char*, Legion::Processor::Kind>;
+using TaskStatsMap = std::map<TaskKey, TaskStats>;
+
+// The buffers are owned here rather than by their threads, so that they survive until the dump
+std::mutex buffers_lock;
+std::vector<std::unique_ptr<TaskStatsMap>> buffers;
+std::atomic<int64_t> node_id{0};
+
+thread_local TaskStatsMap* local_buffer = nullptr;
+
+TaskStatsMap& get_local_buffer()
+{
+  if (nullptr == local_buffer) {
+    std::lock_guard<std::mutex> guard(buffers_lock);
+    buffers.push_back(std::make_unique<TaskStatsMap>());
+    local_buffer = buffers.back().get();
+  }
+  return *local_buffer;
+}
+
+const char* kind_name(Legion::Processor::Kind kind)
+{
+  return kind == Legion::Processor::LOC_PROC   ? "CPU"
+         : kind == Legion::Processor::TOC_PROC ? "GPU"
+                                               : "OpenMP";
+}
+
+double to_us(uint64_t ns) { return ns * 1e-3; }
+
+void dump_csv(FILE* out, const TaskStatsMap& stats)
+{
+  fprintf(out,
+          "task,variant,phase,count,total_us,mean_us,min_us,p50_us,p90_us,p99_us,max_us,"
+          "histogram\n");
+  for (auto& [key, task_stats] : stats) {
+    for (int32_t phase = 0; phase < TaskTimer::NUM_PHASES; ++phase) {
+      auto& phase_stats = task_stats.phases[phase];
+      // Task names can have commas in their template arguments
+      fprintf(out,
+              "\"%s\",%s,%s,%llu,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,",
+              key.first,
+              kind_name(key.second),
+              PHASE_NAMES[phase],
+              static_cast<unsigned long long>(phase_stats.count),
+              to_us(phase_stats.total_ns),
+              to_us(phase_stats.total_ns) / phase_stats.count,
+              to_us(phase_stats.min_ns),
+              to_us(phase_stats.quantile(0.5)),
+              to_us(phase_stats.quantile(0.9)),
+              to_us(phase_stats.quantile(0.99)),
+              to_us(phase_stats.max_ns));
+      for (int32_t idx = 0; idx < NUM_BUCKETS; ++idx)
+        fprintf(out,
+                idx == 0 ? "%llu" : ";%llu",
+                static_cast<unsigned long long>(phase_stats.histogram[idx]));
+      fprintf(out, "\n");
+    }
+  }
+}
+
+void dump_json(FILE* out, const TaskStatsMap& stats)
+{
+  fprintf(out, "{\"histogram_bucket_bounds_ns\": \"[2^i, 2^(i+1))\", \"tasks\": [");
+  bool first = true;
+  for (auto& [key, task_stats] : stats) {
+    fprintf(out,
+            "%s\n  {\"task\": \"%s\", \"variant\": \"%s\"",
+            first ? "" : ",",
+            key.first,
+            kind_name(key.second));
+    first = false;
+    for (int32_t phase = 0; phase < TaskTimer::NUM_PHASES; ++phase) {
+      auto& phase_stats = task_stats.phases[phase];
+      fprintf(out,
+              ", \"%s\": {\"count\": %llu, \"total_us\": %.3f, \"min_us\": %.3f, "
+              "\"p50_us\": %.3f, \"p90_us\": %.3f, \"p99_us\": %.3f, \"max_us\": %.3f, "
+              "\"histogram\": [",
+              PHASE_NAMES[phase],
+              static_cast<unsigned long long>(phase_stats.count),
+              to_us(phase_stats.total_ns),
+              to_us(phase_stats.min_ns),
+              to_us(phase_stats.quantile(0.5)),
+              to_us(phase_stats.quantile(0.9)),
+              to_us(phase_stats.quantile(0.99)),
+              to_us(phase_stats.max_ns));
+      for (int32_t idx = 0; idx < NUM_BUCKETS; ++idx)
+        fprintf(out,
+                idx == 0 ? "%llu" : ", %llu",
+                static_cast<unsigned long long>(phase_stats.histogram[idx]));
+      fprintf(out, "]}");
+    }
+    fprintf(out, "}");
+  }
+  fprintf(out, "\n]}\n");
+}
+
+// Runs at exit, once the processors have stopped running tasks
+void dump_task_stats()
+{
+  TaskStatsMap merged;
+  {
+    std::lock_guard<std::mutex> guard(buffers_lock);
+    for (auto& buffer : buffers)
+      for (auto& [key, task_stats] : *buffer)
+        for (int32_t phase = 0; phase < TaskTimer::NUM_PHASES; ++phase)
+          merged[key].phases[phase].merge(task_stats.phases[phase]);
+  }
+  if (merged.empty()) return;
+
+  const char* prefix = getenv("LEGATE_TASK_STATS_FILE");
+  const char* format = getenv("LEGATE_TASK_STATS_FORMAT");
+  bool json          = format != nullptr && std::string(format) == "json";
+  std::string filename =
+    std::string(prefix != nullptr ? prefix : "legate_task_stats") + "_" +
+    std::to_string(node_id.load(std::memory_order_relaxed)) + (json ? ".json" : ".csv");
+
+  FILE* out = fopen(filename.c_str(), "w");
+  if (nullptr == out) {
+    fprintf(stderr, "Failed to open %s to write the task statistics\n", filename.c_str());
+    return;
+  }
+  if (json)
+    dump_json(out, merged);
+  else
+    dump_csv(out, merged);
+  fclose(out);
+}
+
+}  // namespace
+
+/*static*/ bool TaskTimer::enabled_ = false;
+
+TaskTimer::TaskTimer(const char* task_name, Legion::Processor processor)
+  : task_name_(task_name), processor_(processor)
+{
+  if (enabled_) last_ = std::chrono::steady_clock::now();
+}
+
+TaskTimer::~TaskTimer()
+{
+  if (!enabled_) return;
+  node_id.store(processor_.address_space(), std::memory_order_relaxed);
+  auto& task_stats = get_local_buffer()[TaskKey(task_name_, processor_.kind())];
+  for (int32_t phase = 0; phase < NUM_PHASES; ++phase)
+    task_stats.phases[phase].add(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(durations_[phase]).count());
+}
+
+/*static*/ void TaskTimer::enable()
+{
+  if (enabled_) return;
+  enabled_ = true;
+  atexit(dump_task_stats);
+}
+
+}  // namespace legate
@@ -0,0 +1,72 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+
+#include "legion.h"
+
+namespace legate {
+
+// Opt-in timing of the phases of every Legate task, enabled with LEGATE_TASK_STATS. Each
+// processor thread aggregates the timings into its own buffer, so recording takes no locks.
+// The buffers are merged into per-task histograms and written to a file when the process exits.
+class TaskTimer {
+ public:
+  enum Phase : int32_t {
+    // Construction of the TaskContext, which deserializes the task arguments
+    DESERIALIZE = 0,
+    // The variant itself
+    BODY = 1,
+    // Packing of the return values and the Legion postamble
+    PACK       = 2,
+    NUM_PHASES = 3,
+  };
+
+ public:
+  TaskTimer(const char* task_name, Legion::Processor processor);
+  ~TaskTimer();
+
+ public:
+  TaskTimer(const TaskTimer&)            = delete;
+  TaskTimer& operator=(const TaskTimer&) = delete;
+
+ public:
+  // Ends the given phase, which started when the previous one ended
+  void end_phase(Phase phase)
+  {
+    if (!enabled_) return;
+    auto now = std::chrono::steady_clock::now();
+    durations_[phase] += now - last_;
+    last_ = now;
+  }
+
+ public:
+  // Turns the timers on and sets up the dump of their statistics at exit
+  static void enable();
+
+ private:
+  static bool enabled_;
+
+ private:
+  const char* task_name_;
+  Legion::Processor processor_;
+  std::chrono::steady_clock::time_point last_{};
+  std::chrono::steady_clock::duration durations_[NUM_PHASES]{};
+};
+
+}  // namespace legate
@@ -0,0 +1,142 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <algorithm>
+
+#include "core/utilities/arena.h"
+#include "core/utilities/typedefs.h"
+#include "legate_defines.h"
+
+namespace legate {
+
+namespace {
+
+constexpr size_t MIN_BLOCK_SIZE = 1024;
+// Blocks kept for reuse by each thread. Larger blocks are freed rather than cached, so that a
+// task with unusually many arguments doesn't pin its memory to the thread for good.
+constexpr int32_t MAX_CACHED_BLOCKS    = 8;
+constexpr size_t MAX_CACHED_BLOCK_SIZE = 16384;
+
+size_t align_up(size_t value, size_t alignment)
+{
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+}  // namespace
+
+struct TaskArena::Block {
+  Block* next;
+  size_t capacity;
+
+  static size_t header_size() { return align_up(sizeof(Block), alignof(std::max_align_t)); }
+  char* data() { return reinterpret_cast<char*>(this) + header_size(); }
+};
+
+TaskArena::~TaskArena()
+{
+#ifdef DEBUG_LEGATE
+  // A store copied out of its task would otherwise be left with a dangling transform stack
+  if (num_live_allocations_ > 0) {
+    log_legate.error(
+      "%zu objects allocated for a task outlived it. Stores must not be kept after their task "
+      "returns",
+      num_live_allocations_);
+    LEGATE_ABORT;
+  }
+#endif
+  while (blocks_ != nullptr) {
+    auto next = blocks_->next;
+    release_block(blocks_);
+    blocks_ = next;
+  }
+}
+
+void* TaskArena::allocate(size_t size, size_t alignment)
+{
+  auto ptr = reinterpret_cast<char*>(align_up(reinterpret_cast<uintptr_t>(cursor_), alignment));
+  if (nullptr == blocks_ || ptr + size > end_) {
+    // Later blocks are larger, so a task that outgrows its first block soon stops growing
+    push_block(std::max(size + alignment, nullptr == blocks_ ? 0 : 2 * blocks_->capacity));
+    ptr = reinterpret_cast<char*>(align_up(reinterpret_cast<uintptr_t>(cursor_), alignment));
+  }
+  cursor_ = ptr + size;
+#ifdef DEBUG_LEGATE
+  ++num_live_allocations_;
+#endif
+  return ptr;
+}
+
+void TaskArena::deallocate(void* /*ptr*/, size_t /*size*/)
+{
+#ifdef DEBUG_LEGATE
+  assert(num_live_allocations_ > 0);
+  --num_live_allocations_;
+#endif
+}
+
+void TaskArena::reserve(size_t size)
+{
+  if (nullptr == blocks_ || cursor_ + size > end_) push_block(size);
+}
+
+void TaskArena::push_block(size_t size)
+{
+  auto block  = acquire_block(size);
+  block->next = blocks_;
+  blocks_     = block;
+  cursor_     = block->data();
+  end_        = cursor_ + block->capacity;
+}
+
+struct TaskArena::BlockCache {
+  ~BlockCache()
+  {
+    for (int32_t idx = 0; idx < size; ++idx) free(blocks[idx]);
+  }
+  Block* blocks[MAX_CACHED_BLOCKS];
+  int32_t size{0};
+};
+
+/*static*/ thread_local TaskArena::BlockCache TaskArena::block_cache_{};
+
+/*static*/ TaskArena::Block* TaskArena::acquire_block(size_t size)
+{
+  size = std::max(size, MIN_BLOCK_SIZE);
+  auto& cache = block_cache_;
+  for (int32_t idx = cache.size - 1; idx >= 0; --idx) {
+    auto block = cache.blocks[idx];
+    if (block->capacity < size) continue;
+    cache.blocks[idx] = cache.blocks[--cache.size];
+    return block;
+  }
+  auto block      = static_cast<Block*>(malloc(Block::header_size() + size));
+  block->capacity = size;
+  return block;
+}
+
+/*static*/ void TaskArena::release_block(Block* block)
+{
+  auto& cache = block_cache_;
+  if (cache.size < MAX_CACHED_BLOCKS && block->capacity <= MAX_CACHED_BLOCK_SIZE)
+    cache.blocks[cache.size++] = block;
+  else
+    free(block);
+}
+
+}  // namespace legate
@@ -0,0 +1,97 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+namespace legate {
+
+// Bump allocator for the objects that live exactly as long as a task, such as those created
+// while deserializing its arguments. Memory is only reclaimed in bulk, when the arena is
+// destroyed, and the blocks backing it are recycled across the tasks that run on the same
+// thread, so a short task makes no heap allocation for its arguments once the thread has warmed
+// up. Each arena owns its blocks, which keeps tasks that interleave on one thread apart.
+class TaskArena {
+ public:
+  // The arena takes no block until the first allocation or reservation, so a task that creates
+  // nothing in it costs nothing
+  TaskArena() = default;
+  ~TaskArena();
+
+ public:
+  TaskArena(const TaskArena&)            = delete;
+  TaskArena& operator=(const TaskArena&) = delete;
+
+ public:
+  void* allocate(size_t size, size_t alignment);
+  // Memory is only reclaimed when the arena is destroyed, but with DEBUG_LEGATE the arena checks
+  // that every object drawn from it was released by then
+  void deallocate(void* ptr, size_t size);
+  // Makes sure the next size bytes of allocations fit in the current block, so that a caller that
+  // knows how many objects it is about to create gets a block of the right size up front
+  void reserve(size_t size);
+
+ private:
+  struct Block;
+  struct BlockCache;
+  void push_block(size_t size);
+  static Block* acquire_block(size_t size);
+  static void release_block(Block* block);
+
+ private:
+  // Blocks released by the arenas of the tasks that ran on this thread
+  static thread_local BlockCache block_cache_;
+
+ private:
+  Block* blocks_{nullptr};
+  char* cursor_{nullptr};
+  char* end_{nullptr};
+  // Only tracked with DEBUG_LEGATE, but always present to keep the layout of the arena the same
+  size_t num_live_allocations_{0};
+};
+
+// Allocator that draws from a task arena. Deallocation only matters to the checks of the arena,
+// as the arena releases all of its memory at once.
+template <typename T>
+struct ArenaAllocator {
+  using value_type = T;
+
+  ArenaAllocator(TaskArena* arena) : arena(arena) {}
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena)
+  {
+  }
+
+  T* allocate(size_t n) { return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T))); }
+  void deallocate(T* ptr, size_t n) { arena->deallocate(ptr, n * sizeof(T)); }
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U>& other) const
+  {
+    return arena == other.arena;
+  }
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U>& other) const
+  {
+    return arena != other.arena;
+  }
+
+  TaskArena* arena;
+};
+
+}  // namespace legate
@@ -31,8 +31,9 @@ using namespace Legion::Mapping;
 namespace legate {
 
 TaskDeserializer::TaskDeserializer(const LegionTask* task,
-                                   const std::vector<PhysicalRegion>& regions)
-  : BaseDeserializer(task),
+                                   const std::vector<PhysicalRegion>& regions,
+                                   TaskArena* arena)
+  : BaseDeserializer(task, arena),
     futures_{task->futures.data(), task->futures.size()},
     regions_{regions.data(), regions.size()},
     outputs_()
@@ -72,9 +73,10 @@ void TaskDeserializer::_unpack(Store& value)
 
 void TaskDeserializer::_unpack(FutureWrapper& value)
 {
-  auto read_only   = unpack<bool>();
-  auto has_storage = unpack<bool>();
-  auto field_size  = unpack<int32_t>();
+  auto read_only     = unpack<bool>();
+  auto has_storage   = unpack<bool>();
+  auto field_size    = unpack<int32_t>();
+  auto future_offset = unpack<uint32_t>();
 
   auto point = unpack<std::vector<int64_t>>();
   Legion::Domain domain;
@@ -90,7 +92,8 @@ void TaskDeserializer::_unpack(FutureWrapper& value)
     futures_ = futures_.subspan(1);
   }
 
-  value = FutureWrapper(read_only, field_size, domain, future, has_storage && first_task_);
+  value = FutureWrapper(
+    read_only, field_size, domain, future, future_offset, has_storage && first_task_);
 }
 
 void TaskDeserializer::_unpack(RegionField& value)
@@ -165,6 +168,7 @@ void MapperDeserializer::_unpack(FutureWrapper& value)
   unpack<bool>();
   unpack<bool>();
   unpack<int32_t>();
+  unpack<uint32_t>();
 
   auto point = unpack<std::vector<int64_t>>();
   Legion::Domain domain;
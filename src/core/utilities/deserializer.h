@@ -17,6 +17,7 @@
 #pragma once
 
 #include <memory>
+#include <type_traits>
 
 #include "legion.h"
 
@@ -24,6 +25,7 @@
 #include "core/data/scalar.h"
 #include "core/data/store.h"
 #include "core/mapping/task.h"
+#include "core/utilities/arena.h"
 #include "core/utilities/span.h"
 #include "core/utilities/type_traits.h"
 #include "core/utilities/typedefs.h"
@@ -34,7 +36,7 @@ namespace legate {
 template <typename Deserializer>
 class BaseDeserializer {
  public:
-  BaseDeserializer(const Legion::Task* task);
+  BaseDeserializer(const Legion::Task* task, TaskArena* arena = nullptr);
 
  public:
   template <typename T>
@@ -58,6 +60,8 @@ class BaseDeserializer {
   void _unpack(std::vector<T>& values)
   {
     auto size = unpack<uint32_t>();
+    values.reserve(size);
+    if constexpr (std::is_same_v<T, Store>) reserve_transforms(size);
     for (uint32_t idx = 0; idx < size; ++idx) values.push_back(unpack<T>());
   }
 
@@ -67,10 +71,16 @@ class BaseDeserializer {
 
  protected:
   std::shared_ptr<TransformStack> unpack_transform();
+  // Every store comes with at least one transform stack, so a list of stores sizes the arena
+  void reserve_transforms(uint32_t count);
+  template <typename... Args>
+  std::shared_ptr<TransformStack> make_transform(Args&&... args);
 
  protected:
   const Legion::Task* task_;
   bool first_task_;
+  // Transform stacks are allocated from the arena when one is given
+  TaskArena* arena_;
 
  private:
   Span<const int8_t> task_args_;
@@ -78,7 +88,9 @@ class BaseDeserializer {
 
 class TaskDeserializer : public BaseDeserializer<TaskDeserializer> {
  public:
-  TaskDeserializer(const Legion::Task* task, const std::vector<Legion::PhysicalRegion>& regions);
+  TaskDeserializer(const Legion::Task* task,
+                   const std::vector<Legion::PhysicalRegion>& regions,
+                   TaskArena* arena = nullptr);
 
  public:
   using BaseDeserializer::_unpack;
@@ -17,8 +17,8 @@
 namespace legate {
 
 template <typename Deserializer>
-BaseDeserializer<Deserializer>::BaseDeserializer(const Legion::Task* task)
-  : task_(task), task_args_{static_cast<const int8_t*>(task->args), task->arglen}
+BaseDeserializer<Deserializer>::BaseDeserializer(const Legion::Task* task, TaskArena* arena)
+  : task_(task), arena_(arena), task_args_{static_cast<const int8_t*>(task->args), task->arglen}
 {
 }
 
@@ -37,47 +37,60 @@ void BaseDeserializer<Deserializer>::_unpack(Scalar& value)
   task_args_ = task_args_.subspan(value.size());
 }
 
+template <typename Deserializer>
+void BaseDeserializer<Deserializer>::reserve_transforms(uint32_t count)
+{
+  // Room for the stack and the reference counts that allocate_shared places next to it
+  constexpr size_t TRANSFORM_FOOTPRINT = sizeof(TransformStack) + 4 * sizeof(void*);
+  if (nullptr != arena_ && count > 0) arena_->reserve(count * TRANSFORM_FOOTPRINT);
+}
+
+template <typename Deserializer>
+template <typename... Args>
+std::shared_ptr<TransformStack> BaseDeserializer<Deserializer>::make_transform(Args&&... args)
+{
+  if (nullptr == arena_) return std::make_shared<TransformStack>(std::forward<Args>(args)...);
+  return std::allocate_shared<TransformStack>(ArenaAllocator<TransformStack>(arena_),
+                                              std::forward<Args>(args)...);
+}
+
 template <typename Deserializer>
 std::shared_ptr<TransformStack> BaseDeserializer<Deserializer>::unpack_transform()
 {
   auto code = unpack<int32_t>();
   switch (code) {
     case -1: {
-      return std::make_shared<TransformStack>();
+      return make_transform();
     }
     case LEGATE_CORE_TRANSFORM_SHIFT: {
       auto dim    = unpack<int32_t>();
       auto offset = unpack<int64_t>();
       auto parent = unpack_transform();
-      return std::make_shared<TransformStack>(std::make_unique<Shift>(dim, offset),
-                                              std::move(parent));
+      return make_transform(std::make_unique<Shift>(dim, offset), std::move(parent));
     }
     case LEGATE_CORE_TRANSFORM_PROMOTE: {
       auto extra_dim = unpack<int32_t>();
       auto dim_size  = unpack<int64_t>();
       auto parent    = unpack_transform();
-      return std::make_shared<TransformStack>(std::make_unique<Promote>(extra_dim, dim_size),
-                                              std::move(parent));
+      return make_transform(std::make_unique<Promote>(extra_dim, dim_size), std::move(parent));
     }
     case LEGATE_CORE_TRANSFORM_PROJECT: {
       auto dim    = unpack<int32_t>();
       auto coord  = unpack<int64_t>();
       auto parent = unpack_transform();
-      return std::make_shared<TransformStack>(std::make_unique<Project>(dim, coord),
-                                              std::move(parent));
+      return make_transform(std::make_unique<Project>(dim, coord), std::move(parent));
     }
     case LEGATE_CORE_TRANSFORM_TRANSPOSE: {
       auto axes   = unpack<std::vector<int32_t>>();
       auto parent = unpack_transform();
-      return std::make_shared<TransformStack>(std::make_unique<Transpose>(std::move(axes)),
-                                              std::move(parent));
+      return make_transform(std::make_unique<Transpose>(std::move(axes)), std::move(parent));
     }
     case LEGATE_CORE_TRANSFORM_DELINEARIZE: {
       auto dim    = unpack<int32_t>();
       auto sizes  = unpack<std::vector<int64_t>>();
       auto parent = unpack_transform();
-      return std::make_shared<TransformStack>(std::make_unique<Delinearize>(dim, std::move(sizes)),
-                                              std::move(parent));
+      return make_transform(std::make_unique<Delinearize>(dim, std::move(sizes)),
+                            std::move(parent));
     }
   }
   assert(false);
@@ -0,0 +1,179 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "core/runtime/runtime.h"
+#include "core/utilities/nvtx_help.h"
+
+namespace legate {
+namespace nvtx {
+
+namespace {
+
+constexpr size_t MAX_MESSAGE_LENGTH = 64;
+
+struct TraceEvent {
+  char message[MAX_MESSAGE_LENGTH];
+  uint64_t begin;
+  uint64_t end;
+  Legion::Processor processor;
+};
+
+// Most recent ranges of one thread. Once the buffer is full, new ranges overwrite the oldest.
+struct TraceBuffer {
+  TraceBuffer(int32_t id, size_t capacity) : thread_id(id), events(capacity) {}
+  int32_t thread_id;
+  std::vector<TraceEvent> events;
+  uint64_t num_recorded{0};
+};
+
+size_t buffer_capacity = 0;
+
+// The buffers are owned here rather than by their threads, so that they survive until the dump
+std::mutex buffers_lock;
+std::vector<std::unique_ptr<TraceBuffer>> buffers;
+std::atomic<int64_t> node_id{0};
+
+thread_local TraceBuffer* local_buffer = nullptr;
+
+TraceBuffer& get_local_buffer()
+{
+  if (nullptr == local_buffer) {
+    std::lock_guard<std::mutex> guard(buffers_lock);
+    buffers.push_back(std::make_unique<TraceBuffer>(buffers.size(), buffer_capacity));
+    local_buffer = buffers.back().get();
+  }
+  return *local_buffer;
+}
+
+const char* kind_name(Legion::Processor proc)
+{
+  if (!proc.exists()) return "Thread";
+  auto kind = proc.kind();
+  return kind == Legion::Processor::LOC_PROC   ? "CPU"
+         : kind == Legion::Processor::TOC_PROC ? "GPU"
+         : kind == Legion::Processor::OMP_PROC ? "OpenMP"
+                                               : "Utility";
+}
+
+void write_escaped(FILE* out, const char* message)
+{
+  for (const char* c = message; *c != '\0'; ++c) {
+    if (*c == '"' || *c == '\\')
+      fprintf(out, "\\%c", *c);
+    else if (static_cast<unsigned char>(*c) < 0x20)
+      fprintf(out, "\\u%04x", *c);
+    else
+      fputc(*c, out);
+  }
+}
+
+// Runs at exit, once the processors have stopped running tasks
+void dump_traces()
+{
+  std::lock_guard<std::mutex> guard(buffers_lock);
+  uint64_t origin = UINT64_MAX;
+  for (auto& buffer : buffers) {
+    uint64_t num_events = std::min<uint64_t>(buffer->num_recorded, buffer->events.size());
+    for (uint64_t idx = 0; idx < num_events; ++idx)
+      origin = std::min(origin, buffer->events[idx].begin);
+  }
+  if (UINT64_MAX == origin) return;
+
+  const char* prefix = getenv("LEGATE_TRACE_FILE");
+  int64_t pid        = node_id.load(std::memory_order_relaxed);
+  std::string filename =
+    std::string(prefix != nullptr ? prefix : "legate_trace") + "_" + std::to_string(pid) + ".json";
+  FILE* out = fopen(filename.c_str(), "w");
+  if (nullptr == out) {
+    fprintf(stderr, "Failed to open %s to write the traces\n", filename.c_str());
+    return;
+  }
+
+  fprintf(out, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [");
+  bool first = true;
+  for (auto& buffer : buffers) {
+    uint64_t capacity = buffer->events.size();
+    uint64_t end      = buffer->num_recorded;
+    uint64_t start    = end > capacity ? end - capacity : 0;
+    if (start == end) continue;
+
+    // Name each thread after the processor it last ran on
+    auto proc = buffer->events[(end - 1) % capacity].processor;
+    fprintf(out,
+            "%s\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": %lld, \"tid\": %d, "
+            "\"args\": {\"name\": \"%s 0x" IDFMT "\"}}",
+            first ? "" : ",",
+            static_cast<long long>(pid),
+            buffer->thread_id,
+            kind_name(proc),
+            proc.id);
+    first = false;
+
+    for (uint64_t idx = start; idx < end; ++idx) {
+      auto& event = buffer->events[idx % capacity];
+      fprintf(out, ",\n{\"name\": \"");
+      write_escaped(out, event.message);
+      fprintf(out,
+              "\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": %lld, \"tid\": %d, "
+              "\"args\": {\"proc\": \"0x" IDFMT "\"}}",
+              (event.begin - origin) * 1e-3,
+              (event.end - event.begin) * 1e-3,
+              static_cast<long long>(pid),
+              buffer->thread_id,
+              event.processor.id);
+    }
+  }
+  fprintf(out, "\n]}\n");
+  fclose(out);
+}
+
+}  // namespace
+
+/*static*/ bool Range::tracing_enabled_ = false;
+
+/*static*/ void Range::enable_tracing()
+{
+  if (tracing_enabled_) return;
+  buffer_capacity  = std::max<uint32_t>(extract_env("LEGATE_TRACE_BUFFER_SIZE", 1 << 14, 1), 1);
+  tracing_enabled_ = true;
+  atexit(dump_traces);
+}
+
+/*static*/ void Range::record(const char* message, uint64_t begin, uint64_t end)
+{
+  auto& buffer = get_local_buffer();
+  auto& event  = buffer.events[buffer.num_recorded++ % buffer.events.size()];
+  strncpy(event.message, message, MAX_MESSAGE_LENGTH - 1);
+  event.message[MAX_MESSAGE_LENGTH - 1] = '\0';
+  event.begin                           = begin;
+  event.end                             = end;
+  event.processor                       = Legion::Processor::get_executing_processor();
+  if (event.processor.exists())
+    node_id.store(event.processor.address_space(), std::memory_order_relaxed);
+}
+
+}  // namespace nvtx
+}  // namespace legate
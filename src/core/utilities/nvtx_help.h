@@ -16,25 +16,68 @@
 
 #pragma once
 
-#include "legate.h"
+#include <stdint.h>
+#include <chrono>
 
-#ifdef LEGATE_USE_CUDA
+#include "legion.h"
+
+#include "legate_defines.h"
 
+#ifdef LEGATE_USE_CUDA
 #include <nvtx3/nvToolsExt.h>
+#endif
 
 namespace legate {
 namespace nvtx {
 
+// Marks a range of code, such as a task or a phase of a kernel, for the length of its scope.
+// Ranges go to NVTX on CUDA builds. When LEGATE_TRACE_RANGES is set, they are also recorded on
+// the CPU: each thread keeps its most recent ranges in a ring buffer, and the buffers are written
+// as Chrome trace events, which Perfetto and chrome://tracing can load, when the process exits.
 class Range {
  public:
-  Range(const char* message) { range_ = nvtxRangeStartA(message); }
-  ~Range() { nvtxRangeEnd(range_); }
+  Range(const char* message) : message_(message)
+  {
+#ifdef LEGATE_USE_CUDA
+    range_ = nvtxRangeStartA(message);
+#endif
+    if (tracing_enabled_) begin_ = now();
+  }
+  ~Range()
+  {
+#ifdef LEGATE_USE_CUDA
+    nvtxRangeEnd(range_);
+#endif
+    if (tracing_enabled_ && begin_ != 0) record(message_, begin_, now());
+  }
+
+ public:
+  Range(const Range&)            = delete;
+  Range& operator=(const Range&) = delete;
+
+ public:
+  // Turns on the recording of ranges on the CPU and sets up the dump of the traces at exit
+  static void enable_tracing();
+
+ private:
+  static uint64_t now()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+  }
+  static void record(const char* message, uint64_t begin, uint64_t end);
+
+ private:
+  static bool tracing_enabled_;
 
  private:
+  const char* message_;
+  uint64_t begin_{0};
+#ifdef LEGATE_USE_CUDA
   nvtxRangeId_t range_;
+#endif
 };
 
 }  // namespace nvtx
 }  // namespace legate
-
-#endif
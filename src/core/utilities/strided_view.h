@@ -0,0 +1,151 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include "legion.h"
+
+#include "core/utilities/span.h"
+
+namespace legate {
+
+// Cache line size that tiled iteration aligns to
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+// A raw view of the elements of a rectangle: a pointer to the element at the lower corner and
+// the stride of each dimension in elements. Strides of promoted dimensions are zero.
+template <typename T, int32_t DIM>
+class StridedView {
+ public:
+  StridedView() = default;
+  StridedView(T* ptr, const Legion::Rect<DIM>& shape, const size_t strides[DIM])
+    : ptr_(ptr), shape_(shape)
+  {
+    for (int32_t dim = 0; dim < DIM; ++dim) {
+      extents_[dim] = shape.empty() ? 0 : shape.hi[dim] - shape.lo[dim] + 1;
+      strides_[dim] = strides[dim];
+    }
+  }
+
+ public:
+  T* ptr() const { return ptr_; }
+  const Legion::Rect<DIM>& shape() const { return shape_; }
+  size_t extent(int32_t dim) const { return extents_[dim]; }
+  size_t stride(int32_t dim) const { return strides_[dim]; }
+  size_t pitch(int32_t dim) const { return strides_[dim] * sizeof(T); }
+  size_t volume() const { return shape_.volume(); }
+  bool empty() const { return shape_.empty(); }
+
+ public:
+  // Returns true if the elements are contiguous in row-major order
+  bool dense() const
+  {
+    if (empty()) return true;
+    size_t expected = 1;
+    for (int32_t dim = DIM - 1; dim >= 0; --dim) {
+      if (extents_[dim] == 1) continue;
+      if (strides_[dim] != expected) return false;
+      expected *= extents_[dim];
+    }
+    return true;
+  }
+  // Returns the largest power of two up to the cache line size that the pointer is aligned to
+  size_t alignment() const
+  {
+    auto addr = reinterpret_cast<uintptr_t>(ptr_);
+    if (addr == 0) return CACHE_LINE_SIZE;
+    return std::min<size_t>(addr & -addr, CACHE_LINE_SIZE);
+  }
+  bool is_aligned(size_t bytes) const { return reinterpret_cast<uintptr_t>(ptr_) % bytes == 0; }
+
+ public:
+  // Must only be called on a dense view
+  Span<T> dense_span() const
+  {
+    assert(dense());
+    return Span<T>(ptr_, volume());
+  }
+
+ public:
+  T& operator[](const Legion::Point<DIM>& p) const
+  {
+    size_t offset = 0;
+    for (int32_t dim = 0; dim < DIM; ++dim) offset += (p[dim] - shape_.lo[dim]) * strides_[dim];
+    return ptr_[offset];
+  }
+
+ private:
+  T* ptr_{nullptr};
+  Legion::Rect<DIM> shape_{Legion::Rect<DIM>::make_empty()};
+  size_t extents_[DIM]{};
+  size_t strides_[DIM]{};
+};
+
+// Splits a contiguous run of elements into tiles of `lines` cache lines and calls fn(ptr, count)
+// on each of them. Elements before the first cache line boundary are passed as a shorter tile, so
+// that all the other tiles start on a boundary.
+template <typename T, typename FN>
+void for_each_cache_line_tile(T* ptr, size_t count, FN&& fn, size_t lines = 1)
+{
+  const size_t tile_size = std::max<size_t>(lines * CACHE_LINE_SIZE / sizeof(T), 1);
+
+  auto misalignment = reinterpret_cast<uintptr_t>(ptr) % CACHE_LINE_SIZE;
+  if (misalignment != 0 && misalignment % sizeof(T) == 0) {
+    auto head = std::min(count, (CACHE_LINE_SIZE - misalignment) / sizeof(T));
+    fn(ptr, head);
+    ptr += head;
+    count -= head;
+  }
+  while (count > 0) {
+    auto size = std::min(count, tile_size);
+    fn(ptr, size);
+    ptr += size;
+    count -= size;
+  }
+}
+
+// Visits the elements of a view in row-major order as contiguous tiles. A dense view is tiled as
+// one run; otherwise each row of the innermost dimension is tiled separately, or visited one
+// element at a time when the innermost dimension is not contiguous.
+template <typename T, int32_t DIM, typename FN>
+void for_each_cache_line_tile(const StridedView<T, DIM>& view, FN&& fn, size_t lines = 1)
+{
+  if (view.empty()) return;
+
+  if (view.dense()) {
+    for_each_cache_line_tile(view.ptr(), view.volume(), fn, lines);
+    return;
+  }
+
+  if (view.stride(DIM - 1) != 1) {
+    for (Legion::PointInRectIterator<DIM> it(view.shape(), false /*column_major_order*/);
+         it.valid();
+         ++it)
+      fn(&view[*it], 1);
+    return;
+  }
+
+  auto rows            = view.shape();
+  rows.hi[DIM - 1]     = rows.lo[DIM - 1];
+  const size_t row_len = view.extent(DIM - 1);
+  for (Legion::PointInRectIterator<DIM> it(rows, false /*column_major_order*/); it.valid(); ++it)
+    for_each_cache_line_tile(&view[*it], row_len, fn, lines);
+}
+
+}  // namespace legate
@@ -0,0 +1,122 @@
+# Copyright 2022 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import struct
+
+import pytest
+
+from legate.core import Future, get_legate_runtime
+from legate.core.exception import EXCEPTION_STATUS_SIZE, PendingException
+from legate.core.runtime import _RETURN_VALUE_ALIGNMENT, FutureSlice
+
+# The packed futures below are laid out by hand the way compute_layout and
+# pack_header in src/core/task/return.cc lay them out: the number of values
+# and their sizes as uint32 values, then each value at the next multiple of
+# 16 bytes.
+
+
+def pack(values: list[bytes], offsets: list[int]) -> bytes:
+    header = struct.pack(f"{len(values) + 1}I", len(values), *map(len, values))
+    buf = bytearray(offsets[-1] + len(values[-1]))
+    buf[: len(header)] = header
+    for value, offset in zip(values, offsets):
+        buf[offset : offset + len(value)] = value
+    return bytes(buf)
+
+
+def slice_packed(
+    values: list[bytes], offsets: list[int], sizes: list[int]
+) -> list[FutureSlice]:
+    runtime = get_legate_runtime()
+    buf = pack(values, offsets)
+    future = runtime.create_future(buf, len(buf))
+    slices = runtime.slice_return_values(future, sizes)
+    assert all(isinstance(value, FutureSlice) for value in slices)
+    return slices  # type: ignore
+
+
+def test_alignment() -> None:
+    assert _RETURN_VALUE_ALIGNMENT == 16
+
+
+@pytest.mark.parametrize(
+    "values,offsets",
+    [
+        # The header of two values ends on the first boundary
+        ([struct.pack("q", 42), struct.pack("i", -7)], [16, 32]),
+        # The header of four values spills past the first boundary
+        (
+            [
+                struct.pack("Q", 3),
+                struct.pack("d", 1.5),
+                struct.pack("?", True),
+                struct.pack("h", 9),
+            ],
+            [32, 48, 64, 80],
+        ),
+        # Values larger than the alignment push the next one further
+        ([bytes(range(20)), struct.pack("f", 2.0)], [16, 48]),
+    ],
+)
+def test_offsets(values: list[bytes], offsets: list[int]) -> None:
+    slices = slice_packed(values, offsets, [len(value) for value in values])
+    assert [value.offset for value in slices] == offsets
+    for idx, value in enumerate(values):
+        assert slices[idx].get_size() == len(value)
+        assert slices[idx].get_buffer()[:] == value
+
+
+def test_exception_slots() -> None:
+    # An exception is returned as its status only, in the last slot; the
+    # error message is fetched from the node that keeps it
+    status = struct.pack("iIq", 1, 0, 3)
+    assert len(status) == EXCEPTION_STATUS_SIZE
+    values = [struct.pack("q", 5), struct.pack("i", 6), status]
+    offsets = [16, 32, 48]
+    slices = slice_packed(values, offsets, [8, 4, len(status)])
+    assert [value.offset for value in slices] == offsets
+
+    runtime = get_legate_runtime()
+    message = b"message of unknown length"
+    fetched: list[tuple[int, int]] = []
+
+    def fetch_error_message(node: int, point: int) -> Future:
+        fetched.append((node, point))
+        return runtime.create_future(message, len(message))
+
+    pending = PendingException(
+        [KeyError, ValueError], slices[2], fetch_error_message
+    )
+    with pytest.raises(ValueError, match=message.decode()):
+        pending.raise_exception()
+    assert fetched == [(0, 3)]
+
+
+def test_no_exception() -> None:
+    status = struct.pack("iIq", -1, 0, 0)
+    runtime = get_legate_runtime()
+    future = runtime.create_future(status, len(status))
+
+    def fetch_error_message(node: int, point: int) -> Future:
+        assert False, "nothing was raised"
+
+    pending = PendingException([ValueError], future, fetch_error_message)
+    pending.raise_exception()
+
+
+if __name__ == "__main__":
+    import sys
+
+    sys.exit(pytest.main(sys.argv))